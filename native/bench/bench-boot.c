@@ -0,0 +1,59 @@
+/*
+   Boot cost benchmark
+
+   Built twice, as bench-boot started by the newlib crt and as
+   bench-boot-fastcrt started by lib/crt0.o (see the Makefile), and
+   reads the cycles spent getting from reset to main() first thing:
+     TTCR, started by boot_timer_start (see lib/boottimer.S) from the
+     lib/crt0.o reset vector, or under the newlib crt from its
+     _or1k_board_init_early call, wrapped at link time (see
+     lib/boothook.S), which comes
+     before it clears .bss and enables the caches. The few
+     instructions from reset to that call are not counted.
+     the simulator cycle count, through l.nop NOP_GET_TICKS, under
+     or1ksim only, for either crt
+
+   TTCR gives both boot costs on RTL and FPGA targets as well. It
+   reads 0 under a newlib crt that does not call the early board hook.
+
+   Reports under tag 1:
+     crt (0 newlib, 1 lib/crt0.o), TTCR, simulator cycles
+   No PCU counts are reported, the PCU is not programmed before main().
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+
+/* Defined by lib/crt0.o only */
+extern const unsigned long crt0_fast __attribute__ ((weak));
+
+static unsigned long
+boot_sim_cycles(void)
+{
+  register unsigned long r11 asm("r11") = 0;
+
+  /* or1ksim answers NOP_OR1KSIM with a non-zero r11 */
+  asm volatile ("l.nop %1" : "+r" (r11) : "K" (NOP_OR1KSIM));
+  if (!r11)
+    return 0;
+
+  asm volatile ("l.nop %1" : "=r" (r11) : "K" (NOP_GET_TICKS) : "r12");
+
+  return r11;
+}
+
+int
+main(void)
+{
+  unsigned long ttcr = mfspr(SPR_TTCR);
+  unsigned long sim = boot_sim_cycles();
+
+  report(BENCH_TAG(BENCH_ID_BOOT, 1));
+  report(&crt0_fast != 0);
+  report(ttcr);
+  report(sim);
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+/*
+   Cache maintenance operation benchmark
+
+   Times the cache.h range operations over ranges from one line up to
+   the size of the cache, with the lines in three states beforehand:
+     absent - flushed out of the cache
+     clean  - read in
+     dirty  - read in, then written to, which leaves the lines present
+	      under either write policy; on a write through cache
+	      they are clean again and the state times as clean
+   Data cache ranges are timed with dcache_flush_range() (DCBFR),
+   dcache_writeback_range() (DCBWR) and dcache_inval_range() (DCBIR).
+   Instruction cache ranges hold an l.jr r9 stub per line, called to
+   bring the line in for the clean state, and are timed with
+   icache_inval_range() (ICBIR); they have no dirty state.
+
+   Reports the geometry of both caches under tag 0:
+     data line size, data cache size, instruction line size,
+     instruction cache size
+   then for every point the tag followed by:
+     range size, lines, cycles, cycles per line (8.8 fixed point),
+     cycles per KiB
+   Cycles have the cost of a call with a zero size subtracted. Tags
+   are 0xOSK, O the operation (1 DCBFR, 2 DCBWR, 3 DCBIR, 4 ICBIR), S
+   the state (0 absent, 1 clean, 2 dirty) and K log2 of the range size
+   in lines.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+#include "cache.h"
+
+#define CM_ABSENT	0
+#define CM_CLEAN	1
+#define CM_DIRTY	2
+
+extern char end;
+
+struct cm_op
+{
+  unsigned int id;
+  unsigned int states;
+  unsigned int icache;
+  void (*fn) (void *, size_t);
+};
+
+static const struct cm_op cm_ops[] = {
+  { 1, 3, 0, dcache_flush_range },
+  { 2, 3, 0, dcache_writeback_range },
+  { 3, 3, 0, dcache_inval_range },
+  { 4, 2, 1, icache_inval_range },
+};
+
+/* Keeps the warming loads from being optimised away */
+volatile unsigned long cm_sink;
+
+/* Put the lines of the range in the given state */
+static void
+cm_prepare(const struct cm_op *op, char *buf, unsigned long size,
+	   unsigned long line, unsigned int state)
+{
+  unsigned long i, sum = 0;
+
+  if (op->icache)
+    {
+      icache_inval_range(buf, size);
+      if (state == CM_CLEAN)
+	for (i = 0; i < size; i += line)
+	  ((void (*) (void)) (buf + i)) ();
+      return;
+    }
+
+  dcache_flush_range(buf, size);
+  /* Load before storing, a write through cache without write allocate
+     would otherwise leave a stored line absent */
+  for (i = 0; i < size; i += line)
+    {
+      if (state != CM_ABSENT)
+	sum += *(volatile unsigned long *) (buf + i);
+      if (state == CM_DIRTY)
+	*(volatile unsigned long *) (buf + i) = i;
+    }
+  cm_sink = sum;
+}
+
+static unsigned long
+cm_time(const struct cm_op *op, char *buf, unsigned long size)
+{
+  unsigned long start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  op->fn(buf, size);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  return cycles;
+}
+
+static void
+cm_run(const struct cm_op *op, char *buf, unsigned long cfgr)
+{
+  unsigned long line = cache_line(cfgr), max = cache_size(cfgr);
+  unsigned long size, cycles, overhead;
+  unsigned int state, k;
+
+  overhead = cm_time(op, buf, 0);
+
+  for (state = 0; state < op->states; state++)
+    for (k = 0, size = line; size <= max; k++, size <<= 1)
+      {
+	cm_prepare(op, buf, size, line, state);
+	cycles = cm_time(op, buf, size);
+	cycles = cycles > overhead ? cycles - overhead : 0;
+
+	report(BENCH_TAG(BENCH_ID_CACHEMAINT,
+			 (op->id << 8) | (state << 4) | k));
+	report(size);
+	report(size / line);
+	report(cycles);
+	report((cycles << 8) / (size / line));
+	report((cycles << 10) / size);
+	bench_pcu_report();
+      }
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr = mfspr(SPR_DCCFGR), iccfgr = mfspr(SPR_ICCFGR);
+  unsigned long upr = mfspr(SPR_UPR);
+  unsigned long i;
+  unsigned int o;
+  /* Start the ranges on a 64 KiB boundary past the image */
+  char *buf = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *ibuf;
+
+  report(BENCH_TAG(BENCH_ID_CACHEMAINT, 0));
+  report(cache_line(dccfgr));
+  report(cache_size(dccfgr));
+  report(cache_line(iccfgr));
+  report(cache_size(iccfgr));
+
+  /* Return stubs at the start of every instruction cache line */
+  ibuf = buf + cache_size(dccfgr);
+  for (i = 0; i < cache_size(iccfgr); i += cache_line(iccfgr))
+    {
+      ((unsigned long *) (ibuf + i))[0] = OR32_L_JR_R9;
+      ((unsigned long *) (ibuf + i))[1] = OR32_L_NOP;
+    }
+  dcache_flush_range(ibuf, cache_size(iccfgr));
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  for (o = 0; o < sizeof(cm_ops) / sizeof(cm_ops[0]); o++)
+    {
+      if (cm_ops[o].icache)
+	{
+	  if (upr & SPR_UPR_ICP)
+	    cm_run(&cm_ops[o], ibuf, iccfgr);
+	}
+      else if (upr & SPR_UPR_DCP)
+	cm_run(&cm_ops[o], buf, dccfgr);
+    }
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,232 @@
+/*
+   Cached against cache inhibited page benchmark
+
+   The timing counterpart of dtlb_dcache_test() in or1k-mmu.c. One
+   page of RAM is mapped twice through the libsupport page tables (see
+   pgtable.h), one to one with caching and at CIPAGE_ALIAS with
+   PGTABLE_CI, next to the rest of RAM mapped one to one. With the
+   DMMU on, each mapping of the page is timed for:
+     1 loads  - summing every word, four loads per iteration
+     2 stores - writing every word, four stores per iteration
+     3 chase  - a chain of dependent loads, one per cache line
+   after an untimed pass that fills the DTLB and, when cached, the
+   data cache. The page is flushed out of the data cache after the
+   cached run, so the inhibited run sees what it stored, and again
+   before the mappings go. Then CIPAGE_MMIO_READS byte reads of the UART0 line
+   status register and, on boards with one, of an INTGEN register,
+   both mapped with PGTABLE_CI, give the cost of a device register
+   access.
+
+   Reports under tag 0:
+     UPR[DMP], SR[DCE]
+   then for every point the tag followed by:
+     accesses, cycles, cycles per access (8.8 fixed point)
+   Tags are 0xMT, M 1 cached, 2 cache inhibited and T the test above,
+   and 0x301 for UART0 and 0x302 for INTGEN. Without a DMMU only tag 0
+   is reported.
+*/
+
+#include <or1k-support.h>
+#include "spr-defs.h"
+#include "bench.h"
+#include "board.h"
+#include "cache.h"
+#include "pgtable.h"
+#include "vector.h"
+
+/* Bytes of the page timed, and the virtual address of its inhibited
+   mapping, outside of RAM and devices */
+#define CIPAGE_SIZE		4096
+#define CIPAGE_ALIAS		0x40000000
+
+#define CIPAGE_LINE		16
+#define CIPAGE_MMIO_READS	256
+
+/* Line status register of a 16550 */
+#define UART_LSR		5
+
+#define DTLB_VECTOR		0x900
+
+extern char end;
+extern unsigned long _or1k_board_mem_base;
+extern unsigned long _or1k_board_mem_size;
+
+/* Keeps the loads from being optimised away */
+volatile unsigned long cipage_sink;
+
+static unsigned long
+cipage_loads(volatile unsigned long *p)
+{
+  unsigned long i, sum = 0, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < CIPAGE_SIZE / 4; i += 4)
+    sum += p[i] + p[i + 1] + p[i + 2] + p[i + 3];
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  cipage_sink = sum;
+
+  return cycles;
+}
+
+static unsigned long
+cipage_stores(volatile unsigned long *p)
+{
+  unsigned long i, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < CIPAGE_SIZE / 4; i += 4)
+    {
+      p[i] = i;
+      p[i + 1] = i;
+      p[i + 2] = i;
+      p[i + 3] = i;
+    }
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  return cycles;
+}
+
+static unsigned long
+cipage_chase(volatile unsigned long *p)
+{
+  void **q = (void **) p;
+  unsigned long i, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < CIPAGE_SIZE / CIPAGE_LINE; i++)
+    q = (void **) *q;
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  cipage_sink = (unsigned long) q;
+
+  return cycles;
+}
+
+/* Chain through the start of every line, by the address of the mapping
+   it is walked through */
+static void
+cipage_chain(volatile unsigned long *p, unsigned long va)
+{
+  unsigned long i;
+
+  for (i = 0; i + CIPAGE_LINE < CIPAGE_SIZE; i += CIPAGE_LINE)
+    p[i / 4] = va + i + CIPAGE_LINE;
+  p[i / 4] = va;
+}
+
+static unsigned long
+cipage_mmio(volatile unsigned char *reg)
+{
+  unsigned long i, sum = 0, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < CIPAGE_MMIO_READS; i++)
+    sum += *reg;
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  cipage_sink = sum;
+
+  return cycles;
+}
+
+static void
+cipage_report(unsigned int n, unsigned long accesses, unsigned long cycles)
+{
+  report(BENCH_TAG(BENCH_ID_CIPAGE, n));
+  report(accesses);
+  report(cycles);
+  report((cycles << 8) / accesses);
+  bench_pcu_report();
+}
+
+static void
+cipage_run(unsigned int m, unsigned long va)
+{
+  volatile unsigned long *v = (volatile unsigned long *) va;
+
+  cipage_loads(v);
+  cipage_report((m << 4) | 1, CIPAGE_SIZE / 4, cipage_loads(v));
+
+  cipage_stores(v);
+  cipage_report((m << 4) | 2, CIPAGE_SIZE / 4, cipage_stores(v));
+
+  cipage_chain(v, va);
+  cipage_chase(v);
+  cipage_report((m << 4) | 3, CIPAGE_SIZE / CIPAGE_LINE, cipage_chase(v));
+}
+
+int
+main(void)
+{
+  /* The timed page, then the page table pool */
+  char *page = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *pool = page + PGTABLE_PAGE_SIZE;
+  unsigned long pool_size = PGTABLE_PGD_SIZE + PGTABLE_PTE_SIZE *
+    ((_or1k_board_mem_size >> PGTABLE_PGD_SHIFT) + 4);
+  unsigned long upr = mfspr(SPR_UPR);
+  unsigned long saved[VECTOR_PATCH_WORDS];
+
+  report(BENCH_TAG(BENCH_ID_CIPAGE, 0));
+  report(!!(upr & SPR_UPR_DMP));
+  report(!!(mfspr(SPR_SR) & SPR_SR_DCE));
+
+  if (!(upr & SPR_UPR_DMP))
+    {
+      report(0x8000000d);
+      return 0;
+    }
+
+  if (pgtable_init(pool, pool_size) ||
+      map_range(_or1k_board_mem_base, _or1k_board_mem_base,
+		_or1k_board_mem_size, PGTABLE_RW) ||
+      map_range(CIPAGE_ALIAS, (unsigned long) page, PGTABLE_PAGE_SIZE,
+		PGTABLE_RW | PGTABLE_CI) ||
+      map_range(UART0_BASE, UART0_BASE, PGTABLE_PAGE_SIZE,
+		PGTABLE_RW | PGTABLE_CI)
+#ifdef INTGEN_BASE
+      || map_range(INTGEN_BASE, INTGEN_BASE, PGTABLE_PAGE_SIZE,
+		   PGTABLE_RW | PGTABLE_CI)
+#endif
+      )
+    {
+      report(0xbaaaaaad);
+      return 1;
+    }
+
+  vector_patch(DTLB_VECTOR, pgtable_dtlb_miss, saved);
+
+  bench_timer_start();
+  bench_pcu_setup();
+  or1k_dmmu_enable();
+
+  cipage_run(1, (unsigned long) page);
+  dcache_flush_range(page, CIPAGE_SIZE);
+  cipage_run(2, CIPAGE_ALIAS);
+
+  cipage_mmio((volatile unsigned char *) UART0_BASE + UART_LSR);
+  cipage_report(0x301, CIPAGE_MMIO_READS,
+		cipage_mmio((volatile unsigned char *) UART0_BASE + UART_LSR));
+#ifdef INTGEN_BASE
+  cipage_mmio((volatile unsigned char *) INTGEN_BASE);
+  cipage_report(0x302, CIPAGE_MMIO_READS,
+		cipage_mmio((volatile unsigned char *) INTGEN_BASE));
+#endif
+
+  dcache_flush_range(page, CIPAGE_SIZE);
+  or1k_dmmu_disable();
+  unmap_range(CIPAGE_ALIAS, PGTABLE_PAGE_SIZE);
+  vector_restore(DTLB_VECTOR, saved);
+
+  report(0x8000000d);
+
+  return 0;
+}
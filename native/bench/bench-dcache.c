@@ -0,0 +1,115 @@
+/*
+   Data cache working-set sweep
+
+   lat_mem_rd style pointer chase. For each stride a chain of pointers
+   is laid through working sets from CHASE_MIN_SIZE up to CHASE_MAX_SIZE
+   bytes, walked once to warm up, then CHASE_LOADS dependent loads are
+   timed with the tick timer. Plotting cycles per load against the size
+   shows the L1 capacity, stepping the stride shows the line size, and
+   the plateau past the capacity is the miss penalty of the memory
+   configuration in use.
+
+   Reports the data cache geometry, decoded from DCCFGR the same way
+   _cache_init does, under tag 0:
+     line size, number of sets, number of ways, SR[DCE]
+   then for every point the tag followed by:
+     working set size, stride, cycles, cycles per load (8.8 fixed point)
+
+   The working sets are laid out past the end of the program image.
+   Reduce CHASE_MAX_SIZE for targets with less than 8 MiB of RAM.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+
+#define CHASE_MIN_SIZE	1024
+#define CHASE_MAX_SIZE	(4 << 20)
+
+/* Timed loads per point, 2^12 */
+#define CHASE_LOADS	4096
+#define CHASE_SHIFT	4
+
+#define CHASE4	p = (void **) *p; p = (void **) *p; \
+		p = (void **) *p; p = (void **) *p;
+#define CHASE16	CHASE4 CHASE4 CHASE4 CHASE4
+
+extern char end;
+
+static const unsigned long strides[] = { 4, 16, 64, 256 };
+
+/* Keeps the chase from being optimised away */
+void * volatile chase_sink;
+
+static void **
+chase_build(char *buf, unsigned long size, unsigned long stride)
+{
+  unsigned long i;
+
+  for (i = 0; i + stride < size; i += stride)
+    *(void **) (buf + i) = buf + i + stride;
+  *(void **) (buf + i) = buf;
+
+  return (void **) buf;
+}
+
+static unsigned long
+chase_time(void **p, unsigned long size, unsigned long stride)
+{
+  unsigned long i, start, cycles;
+
+  for (i = size / stride; i; i--)
+    p = (void **) *p;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = CHASE_LOADS / 16; i; i--)
+    {
+      CHASE16
+    }
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  chase_sink = p;
+
+  return cycles;
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr, size, stride, cycles;
+  unsigned int s, k;
+  /* Start the working sets on a 64 KiB boundary past the image */
+  char *buf = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+
+  dccfgr = mfspr(SPR_DCCFGR);
+  report(BENCH_TAG(BENCH_ID_DCACHE, 0));
+  report(16 << ((dccfgr & SPR_DCCFGR_CBS) >> SPR_DCCFGR_CBS_OFF));
+  report(1 << ((dccfgr & SPR_DCCFGR_NCS) >> SPR_DCCFGR_NCS_OFF));
+  report(1 << ((dccfgr & SPR_DCCFGR_NCW) >> SPR_DCCFGR_NCW_OFF));
+  report(!!(mfspr(SPR_SR) & SPR_SR_DCE));
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  for (s = 0; s < sizeof(strides) / sizeof(strides[0]); s++)
+    {
+      stride = strides[s];
+      for (k = 0, size = CHASE_MIN_SIZE; size <= CHASE_MAX_SIZE;
+	   k++, size <<= 1)
+	{
+	  cycles = chase_time(chase_build(buf, size, stride), size, stride);
+
+	  report(BENCH_TAG(BENCH_ID_DCACHE, ((s + 1) << 8) | k));
+	  report(size);
+	  report(stride);
+	  report(cycles);
+	  report(cycles >> CHASE_SHIFT);
+	  bench_pcu_report();
+	}
+    }
+
+  report(0x8000000d);
+
+  return 0;
+}
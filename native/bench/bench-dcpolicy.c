@@ -0,0 +1,214 @@
+/*
+   Data cache write policy benchmark
+
+   Four workloads to run on write back and write through builds of
+   the core, or under or1ksim with etc/or1ksim/sim-dcwb.cfg and
+   sim-dcwt.cfg, their cycles side by side with
+   bench/dcpolicy-table.sh:
+     1 fill  - stores every word of twice the cache
+     2 rmw   - increments every word of twice the cache
+     3 mixed - DCPOLICY_PASSES passes over half the cache, loading
+	       every word and storing every fourth
+     4 dma   - DCPOLICY_ROUNDS rounds of writing a DCPOLICY_PACKET
+	       byte packet, flushing it for a device to read,
+	       invalidating it as if a device wrote it, and reading it
+   The first three end with a flush, so the time includes getting the
+   dirty lines out to memory. Every workload starts with its buffer
+   flushed out of the cache.
+
+   The bus counts are not measured but modelled from the access
+   pattern of each workload, below, for the policy in DCCFGR[CWS]
+   unless the build sets it with DCPOLICY_WB, 1 for write back and 0 for write through (see
+   the Makefile). or1ksim always reports write through and its write
+   back config only changes the store delays, so runs with
+   sim-dcwb.cfg need DCPOLICY_WB=1.
+
+   Reports under tag 0:
+     DCCFGR[CWS], bus model (1 write back), line size, cache size,
+     SR[DCE]
+   then for every workload the tag followed by:
+     bytes, cycles, modelled bus reads, modelled bus writes,
+     modelled bus transactions
+   Tags are the workload number. The model counts one line fill per
+   line missed, then for write through one word write per store,
+   without allocating on a store miss, and for write back one line
+   fill per store miss and one line write per dirty line.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+#include "cache.h"
+
+#define DCPOLICY_MIN_SIZE	4096
+#define DCPOLICY_PASSES		4
+#define DCPOLICY_PACKET		1024
+#define DCPOLICY_ROUNDS		16
+
+extern char end;
+
+struct dcpolicy_bus
+{
+  unsigned long reads;
+  unsigned long writes;
+};
+
+/* Keeps the loads from being optimised away */
+volatile unsigned long dcpolicy_sink;
+
+static unsigned long
+fill(volatile unsigned long *buf, unsigned long size, unsigned long line,
+     int wb, struct dcpolicy_bus *bus)
+{
+  unsigned long i, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < size / 4; i++)
+    buf[i] = i;
+  dcache_flush_range((void *) buf, size);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  bus->reads = wb ? size / line : 0;
+  bus->writes = wb ? size / line : size / 4;
+
+  return cycles;
+}
+
+static unsigned long
+rmw(volatile unsigned long *buf, unsigned long size, unsigned long line,
+    int wb, struct dcpolicy_bus *bus)
+{
+  unsigned long i, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < size / 4; i++)
+    buf[i] += 1;
+  dcache_flush_range((void *) buf, size);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  bus->reads = size / line;
+  bus->writes = wb ? size / line : size / 4;
+
+  return cycles;
+}
+
+static unsigned long
+mixed(volatile unsigned long *buf, unsigned long size, unsigned long line,
+      int wb, struct dcpolicy_bus *bus)
+{
+  unsigned long i, p, sum = 0, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (p = 0; p < DCPOLICY_PASSES; p++)
+    for (i = 0; i < size / 4; i += 4)
+      {
+	sum += buf[i] + buf[i + 1] + buf[i + 2] + buf[i + 3];
+	buf[i] = sum;
+      }
+  dcache_flush_range((void *) buf, size);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  dcpolicy_sink = sum;
+
+  bus->reads = size / line;
+  bus->writes = wb ? size / line : DCPOLICY_PASSES * size / 16;
+
+  return cycles;
+}
+
+static unsigned long
+dma(volatile unsigned long *buf, unsigned long size, unsigned long line,
+    int wb, struct dcpolicy_bus *bus)
+{
+  unsigned long i, r, sum = 0, start, cycles;
+
+  pcu_start();
+  start = bench_timer_read();
+  for (r = 0; r < DCPOLICY_ROUNDS; r++)
+    {
+      for (i = 0; i < size / 4; i++)
+	buf[i] = r + i;
+      dcache_flush_range((void *) buf, size);
+      dcache_inval_range((void *) buf, size);
+      for (i = 0; i < size / 4; i++)
+	sum += buf[i];
+    }
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  dcpolicy_sink = sum;
+
+  bus->reads = DCPOLICY_ROUNDS * (wb ? 2 : 1) * size / line;
+  bus->writes = DCPOLICY_ROUNDS * (wb ? size / line : size / 4);
+
+  return cycles;
+}
+
+static void
+dcpolicy_run(unsigned int n,
+	     unsigned long (*workload) (volatile unsigned long *,
+					unsigned long, unsigned long, int,
+					struct dcpolicy_bus *),
+	     volatile unsigned long *buf, unsigned long size,
+	     unsigned long line, int wb)
+{
+  struct dcpolicy_bus bus;
+  unsigned long cycles;
+
+  dcache_flush_range((void *) buf, size);
+  cycles = workload(buf, size, line, wb, &bus);
+
+  report(BENCH_TAG(BENCH_ID_DCPOLICY, n));
+  report(size);
+  report(cycles);
+  report(bus.reads);
+  report(bus.writes);
+  report(bus.reads + bus.writes);
+  bench_pcu_report();
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr = mfspr(SPR_DCCFGR);
+  unsigned long line, size, twice;
+#ifdef DCPOLICY_WB
+  int wb = DCPOLICY_WB;
+#else
+  int wb = !!(dccfgr & SPR_DCCFGR_CWS);
+#endif
+  /* Start the buffer on a 64 KiB boundary past the image */
+  volatile unsigned long *buf = (volatile unsigned long *)
+    (((unsigned long) &end + 0xffff) & ~0xffff);
+
+  line = 16 << ((dccfgr & SPR_DCCFGR_CBS) >> SPR_DCCFGR_CBS_OFF);
+  size = line << ((dccfgr & SPR_DCCFGR_NCS) >> SPR_DCCFGR_NCS_OFF)
+    << ((dccfgr & SPR_DCCFGR_NCW) >> SPR_DCCFGR_NCW_OFF);
+  twice = 2 * size;
+  if (twice < DCPOLICY_MIN_SIZE)
+    twice = DCPOLICY_MIN_SIZE;
+
+  report(BENCH_TAG(BENCH_ID_DCPOLICY, 0));
+  report(!!(dccfgr & SPR_DCCFGR_CWS));
+  report(wb);
+  report(line);
+  report(size);
+  report(!!(mfspr(SPR_SR) & SPR_SR_DCE));
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  dcpolicy_run(1, fill, buf, twice, line, wb);
+  dcpolicy_run(2, rmw, buf, twice, line, wb);
+  dcpolicy_run(3, mixed, buf, twice / 4, line, wb);
+  dcpolicy_run(4, dma, buf, DCPOLICY_PACKET, line, wb);
+
+  report(0x8000000d);
+
+  return 0;
+}
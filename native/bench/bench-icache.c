@@ -0,0 +1,119 @@
+/*
+   Instruction cache footprint benchmark
+
+   Times the kernels generated by gen-icache-kernels.sh, blocks of
+   independent l.addi from 256 bytes upwards, once straight through
+   (one pass of the block) and looped ICACHE_LOOPS times, each after an
+   untimed warm-up call. Kernels up to ICACHE_SPAN times the I-cache size
+   read from ICCFGR are run, or all of them when there is no I-cache.
+   The sweep is run with SR[ICE] as left by the startup code, tagging
+   the straight-line kernels 0x1nn and the looped ones 0x2nn, and again
+   with the I-cache disabled using 0x3nn and 0x4nn.
+
+   The largest kernel is set at build time by ICACHE_SIZE in the
+   Makefile. When it is smaller than ICACHE_SPAN times the I-cache
+   the sweep stops short of that, which the last value of tag 0 shows.
+
+   Reports the I-cache geometry under tag 0:
+     line size, number of sets, number of ways, total size, largest
+     kernel
+   then for every kernel the tag followed by:
+     footprint, iterations, cycles, cycles per instruction (8.8 fixed
+     point, loop tail instructions included)
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+
+#define ICACHE_LOOPS	8
+#define ICACHE_SPAN	8
+
+#ifdef __OR1K_NODELAY__
+#define ICACHE_TAIL_INSNS	3
+#else
+#define ICACHE_TAIL_INSNS	4
+#endif
+
+struct icache_kernel
+{
+  unsigned long size;
+  void (*fn) (unsigned long iterations);
+};
+
+extern const struct icache_kernel icache_kernels[];
+
+static void
+icache_run(unsigned long tag, const struct icache_kernel *k,
+	   unsigned long iterations)
+{
+  unsigned long start, cycles, insns;
+
+  k->fn(iterations);
+
+  pcu_start();
+  start = bench_timer_read();
+  k->fn(iterations);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  insns = iterations * (k->size / 4 + ICACHE_TAIL_INSNS);
+
+  report(tag);
+  report(k->size);
+  report(iterations);
+  report(cycles);
+  report((cycles << 8) / insns);
+  bench_pcu_report();
+}
+
+static void
+icache_sweep(unsigned long max_size, unsigned int base)
+{
+  const struct icache_kernel *k;
+  unsigned int n;
+
+  for (k = icache_kernels, n = 0; k->size && k->size <= max_size; k++, n++)
+    {
+      icache_run(BENCH_TAG(BENCH_ID_ICACHE, base + 0x100 + n), k, 1);
+      icache_run(BENCH_TAG(BENCH_ID_ICACHE, base + 0x200 + n), k,
+		 ICACHE_LOOPS);
+    }
+}
+
+int
+main(void)
+{
+  const struct icache_kernel *k;
+  unsigned long iccfgr, line, sets, ways, largest = 0, max_size = ~0ul;
+
+  iccfgr = mfspr(SPR_ICCFGR);
+  line = 16 << ((iccfgr & SPR_ICCFGR_CBS) >> SPR_ICCFGR_CBS_OFF);
+  sets = 1 << ((iccfgr & SPR_ICCFGR_NCS) >> SPR_ICCFGR_NCS_OFF);
+  ways = 1 << ((iccfgr & SPR_ICCFGR_NCW) >> SPR_ICCFGR_NCW_OFF);
+
+  report(BENCH_TAG(BENCH_ID_ICACHE, 0));
+  report(line);
+  report(sets);
+  report(ways);
+  report(line * sets * ways);
+
+  for (k = icache_kernels; k->size; k++)
+    largest = k->size;
+  report(largest);
+
+  if (mfspr(SPR_UPR) & SPR_UPR_ICP)
+    max_size = ICACHE_SPAN * line * sets * ways;
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  icache_sweep(max_size, 0);
+
+  /* Again without the I-cache */
+  mtspr(SPR_SR, mfspr(SPR_SR) & ~SPR_SR_ICE);
+  icache_sweep(max_size, 0x200);
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+/*
+   Interrupt latency benchmark
+
+   Raises INTGEN interrupts IRQ_SAMPLES times and timestamps them with
+   TTCR at three points: just before write_intgen_reg() schedules the
+   interrupt INTGEN_DELAY cycles ahead, on entry to and exit from the
+   handler, and back in the interrupted loop.
+
+   Two paths are measured:
+     1 a raw handler jumped to straight from the patched 0x800 vector
+       (see vector.h), which only saves r3
+     2 a C handler registered with or1k_interrupt_handler_add(), run
+       through the newlib exception and interrupt dispatch
+
+   Reports tag 0 followed by the sample count and INTGEN_DELAY, then for
+   every path and measurement the tag followed by:
+     min, median, max cycles
+   Tags are 0xPM, P the path and M the measurement (1 trigger to
+   handler entry, INTGEN_DELAY included, 2 handler exit to back in the
+   loop).
+
+   Boards without INTGEN in board.h only report tag 0. No PCU counts
+   are reported, the samples are timestamps taken across the interrupt
+   rather than timed regions.
+*/
+
+#include <stdlib.h>
+#include <or1k-support.h>
+#include "spr-defs.h"
+#include "board.h"
+#include "bench.h"
+#include "vector.h"
+
+#define IRQ_SAMPLES	2048
+#define INTGEN_DELAY	1
+
+#define IRQ_VECTOR	0x800
+
+/* Raw handler scratch words relative to r0, after the ones in
+   tlbrefill.h */
+#define IRQ_SAVE_R3	0x40
+#define IRQ_ENTRY	0x44
+#define IRQ_EXIT	0x48
+
+#define IRQ_VAR(off)	(*(volatile unsigned long *) (off))
+
+#define STR(x)	#x
+#define XSTR(x)	STR(x)
+
+#ifdef INTGEN_BASE
+
+static unsigned long entry[IRQ_SAMPLES];
+static unsigned long ret[IRQ_SAMPLES];
+
+void irq_raw_handler(void);
+
+asm(
+"	.global	irq_raw_handler\n"
+"	.type	irq_raw_handler,@function\n"
+"irq_raw_handler:\n"
+"	l.sw	" XSTR(IRQ_SAVE_R3) "(r0), r3\n"
+"	l.mfspr	r3, r0, " XSTR(SPR_TTCR) "\n"
+"	l.sw	" XSTR(IRQ_ENTRY) "(r0), r3\n"
+"	l.movhi	r3, hi(" XSTR(INTGEN_BASE) ")\n"
+"	l.sb	1(r3), r0\n"
+"	l.mfspr	r3, r0, " XSTR(SPR_PICSR) "\n"
+"	l.mtspr	r0, r3, " XSTR(SPR_PICSR) "\n"
+"	l.mfspr	r3, r0, " XSTR(SPR_TTCR) "\n"
+"	l.sw	" XSTR(IRQ_EXIT) "(r0), r3\n"
+"	l.lwz	r3, " XSTR(IRQ_SAVE_R3) "(r0)\n"
+"	l.rfe\n");
+
+static void write_intgen_reg(unsigned long reg, int value)
+{
+  *(volatile unsigned char *) (INTGEN_BASE + reg) = value;
+}
+
+static void intgen_isr(void *data)
+{
+  IRQ_VAR(IRQ_ENTRY) = mfspr(SPR_TTCR);
+  write_intgen_reg(1, 0);
+  IRQ_VAR(IRQ_EXIT) = mfspr(SPR_TTCR);
+}
+
+static int
+compare(const void *a, const void *b)
+{
+  unsigned long x = *(const unsigned long *) a;
+  unsigned long y = *(const unsigned long *) b;
+
+  return x < y ? -1 : x > y;
+}
+
+static void
+report_spread(unsigned long tag, unsigned long *samples)
+{
+  qsort(samples, IRQ_SAMPLES, sizeof(samples[0]), compare);
+
+  report(tag);
+  report(samples[0]);
+  report(samples[IRQ_SAMPLES / 2]);
+  report(samples[IRQ_SAMPLES - 1]);
+}
+
+static void
+irq_run(unsigned int path)
+{
+  unsigned long i, start, back;
+
+  for (i = 0; i < IRQ_SAMPLES; i++)
+    {
+      IRQ_VAR(IRQ_EXIT) = 0;
+
+      start = mfspr(SPR_TTCR);
+      write_intgen_reg(0, INTGEN_DELAY);
+      while (!IRQ_VAR(IRQ_EXIT))
+	;
+      back = mfspr(SPR_TTCR);
+
+      entry[i] = IRQ_VAR(IRQ_ENTRY) - start;
+      ret[i] = back - IRQ_VAR(IRQ_EXIT);
+    }
+
+  report_spread(BENCH_TAG(BENCH_ID_IRQ, (path << 4) | 1), entry);
+  report_spread(BENCH_TAG(BENCH_ID_IRQ, (path << 4) | 2), ret);
+}
+
+#endif
+
+int
+main(void)
+{
+#ifdef INTGEN_BASE
+  unsigned long saved[VECTOR_PATCH_WORDS];
+#endif
+
+  report(BENCH_TAG(BENCH_ID_IRQ, 0));
+  report(IRQ_SAMPLES);
+  report(INTGEN_DELAY);
+
+#ifdef INTGEN_BASE
+  /* The handlers stamp with TTCR whatever the timer.h cycle source */
+  mtspr(SPR_TTMR, BENCH_TTMR_FREERUN);
+
+  or1k_interrupt_handler_add(INTGEN_IRQ, intgen_isr, 0);
+  or1k_interrupt_enable(INTGEN_IRQ);
+  mtspr(SPR_SR, mfspr(SPR_SR) | SPR_SR_IEE);
+
+  vector_patch(IRQ_VECTOR, irq_raw_handler, saved);
+  irq_run(1);
+  vector_restore(IRQ_VECTOR, saved);
+
+  irq_run(2);
+
+  mtspr(SPR_SR, mfspr(SPR_SR) & ~SPR_SR_IEE);
+#endif
+
+  report(0x8000000d);
+
+  return 0;
+}
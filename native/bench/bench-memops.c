@@ -0,0 +1,205 @@
+/*
+   Memory routine benchmark
+
+   Compares the libsupport fast_memcpy, fast_memset, fast_memmove and
+   fast_memcmp (see fastmem.h) with the newlib routines for sizes from
+   1 byte to 64 KiB in powers of two, with word aligned buffers and with
+   both buffers one byte past a word boundary. memmove copies to an
+   overlapping destination four bytes up, memcmp compares equal buffers.
+   Small sizes are repeated so every point runs at least MEMOPS_BYTES
+   bytes.
+
+   Every fast routine is checked against the expected result first, a
+   mismatch reports the tag, the size and 0xbaaaaaad and fails the test.
+   Before that fast_memcpy and fast_memcmp are checked for every pair of
+   source and destination offsets from a word boundary and sizes up to
+   MEMOPS_MIX_SIZE, which covers the byte paths taken when the two
+   offsets differ. A mismatch there reports tag 0xFOSD, O the routine,
+   S and D the offsets, the size and 0xbaaaaaad.
+
+   For every point reports the tag followed by:
+     size, newlib cycles per call, fast cycles per call
+   each cycle count followed by the PCU counts over all the calls it
+   averages, on cores with performance counters (see bench.h).
+   Tags are 0xAOSS, A the alignment (0 aligned, 1 offset by one byte), O
+   the routine (1 memcpy, 2 memset, 3 memmove, 4 memcmp) and SS log2 of
+   the size.
+*/
+
+#include <string.h>
+#include "bench.h"
+#include "fastmem.h"
+
+#define MEMOPS_MAX_SIZE	(64 << 10)
+#define MEMOPS_BYTES	4096
+#define MEMOPS_MIX_SIZE	67
+
+extern char end;
+
+typedef int (*memop_fn) (char *dst, char *src, size_t n);
+
+static int newlib_memcpy(char *dst, char *src, size_t n)
+{ memcpy(dst, src, n); return 0; }
+static int newlib_memset(char *dst, char *src, size_t n)
+{ memset(dst, 0x5a, n); return 0; }
+static int newlib_memmove(char *dst, char *src, size_t n)
+{ memmove(dst + 4, dst, n); return 0; }
+static int newlib_memcmp(char *dst, char *src, size_t n)
+{ return memcmp(dst, src, n); }
+
+static int lib_memcpy(char *dst, char *src, size_t n)
+{ fast_memcpy(dst, src, n); return 0; }
+static int lib_memset(char *dst, char *src, size_t n)
+{ fast_memset(dst, 0x5a, n); return 0; }
+static int lib_memmove(char *dst, char *src, size_t n)
+{ fast_memmove(dst + 4, dst, n); return 0; }
+static int lib_memcmp(char *dst, char *src, size_t n)
+{ return fast_memcmp(dst, src, n); }
+
+static const memop_fn newlib_ops[4] =
+  { newlib_memcpy, newlib_memset, newlib_memmove, newlib_memcmp };
+static const memop_fn lib_ops[4] =
+  { lib_memcpy, lib_memset, lib_memmove, lib_memcmp };
+
+static void
+fill(char *buf, size_t n, unsigned int seed)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    buf[i] = seed + i * 7;
+}
+
+/* Returns non-zero when the fast routine gives a wrong result */
+static int
+check(unsigned int op, char *dst, char *src, size_t n)
+{
+  size_t i;
+
+  fill(src, n + 4, 1);
+  fill(dst, n + 4, 2);
+
+  switch (op)
+    {
+    case 0:
+      fast_memcpy(dst, src, n);
+      return memcmp(dst, src, n) != 0 || dst[n] != (char) (2 + n * 7);
+    case 1:
+      fast_memset(dst, 0x5a, n);
+      for (i = 0; i < n; i++)
+	if (dst[i] != 0x5a)
+	  return 1;
+      return dst[n] != (char) (2 + n * 7);
+    case 2:
+      fill(dst, n + 4, 1);
+      fast_memmove(dst + 4, dst, n);
+      return memcmp(dst + 4, src, n) != 0;
+    default:
+      memcpy(dst, src, n);
+      if (fast_memcmp(dst, src, n) != 0)
+	return 1;
+      dst[n - 1] ^= 0x80;
+      return (fast_memcmp(dst, src, n) < 0) != (memcmp(dst, src, n) < 0);
+    }
+}
+
+/* fast_memcpy and fast_memcmp with every source and destination
+   alignment, returns non-zero after reporting a mismatch */
+static int
+check_mixed(char *base)
+{
+  char *src, *dst;
+  unsigned int op, sa, da;
+  size_t n;
+
+  for (op = 0; op < 4; op += 3)
+    for (sa = 0; sa < 4; sa++)
+      for (da = 0; da < 4; da++)
+	for (n = 1; n <= MEMOPS_MIX_SIZE; n++)
+	  {
+	    src = base + sa;
+	    dst = base + MEMOPS_MAX_SIZE + 64 + da;
+
+	    if (check(op, dst, src, n))
+	      {
+		report(BENCH_TAG(BENCH_ID_MEMOPS, 0xf000 | ((op + 1) << 8) |
+				 (sa << 4) | da));
+		report(n);
+		report(0xbaaaaaad);
+		return 1;
+	      }
+	  }
+
+  return 0;
+}
+
+static unsigned long
+time_op(memop_fn fn, char *dst, char *src, size_t n, unsigned long reps)
+{
+  unsigned long i, start;
+
+  unsigned long cycles;
+
+  fn(dst, src, n);
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < reps; i++)
+    fn(dst, src, n);
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  return cycles / reps;
+}
+
+int
+main(void)
+{
+  char *base = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *src, *dst;
+  unsigned long tag, reps;
+  unsigned int align, op, log2n;
+  size_t n;
+
+  if (check_mixed(base))
+    return 1;
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  for (align = 0; align < 2; align++)
+    {
+      src = base + align;
+      dst = base + MEMOPS_MAX_SIZE + 64 + align;
+
+      for (op = 0; op < 4; op++)
+	for (log2n = 0, n = 1; n <= MEMOPS_MAX_SIZE; log2n++, n <<= 1)
+	  {
+	    tag = BENCH_TAG(BENCH_ID_MEMOPS,
+			    (align << 12) | ((op + 1) << 8) | log2n);
+	    reps = n < MEMOPS_BYTES ? MEMOPS_BYTES / n : 1;
+
+	    if (check(op, dst, src, n))
+	      {
+		report(tag);
+		report(n);
+		report(0xbaaaaaad);
+		return 1;
+	      }
+
+	    fill(src, n + 4, 1);
+	    fill(dst, n + 4, 1);
+
+	    report(tag);
+	    report(n);
+	    report(time_op(newlib_ops[op], dst, src, n, reps));
+	    bench_pcu_report();
+	    report(time_op(lib_ops[op], dst, src, n, reps));
+	    bench_pcu_report();
+	  }
+    }
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/*
+   Cache block prefetch and lock benchmark
+
+   Stream: sums PREFETCH_SIZE bytes flushed out of the data cache a
+   line at a time, writing DCBPR for the line the given distance ahead
+   before summing each line. Distance 0 writes no DCBPR and is the
+   baseline.
+
+   Hot lines: stands in for an interrupt handler with HOT_LINES lines
+   of code, a chain of l.nop ending in l.jr r9, and HOT_LINES lines of
+   data it sums. Between HOT_CALLS calls the rest of the program
+   evicts both caches, by calling an l.jr r9 stub in every line of
+   twice the instruction cache and reading every line of twice the
+   data cache. The run is timed with the hot lines unlocked, then
+   again after ICBLR and DCBLR on them; a flush and an invalidate
+   unlock them afterwards.
+
+   Reports under tag 0:
+     DCCFGR, ICCFGR (CBPRI and CBLRI tell whether the block prefetch
+     and lock registers exist)
+   then for every point the tag followed by:
+     distance or locked, cycles, cycles saved over the baseline
+   Stream tags are 0x1DD, DD the distance in lines, hot line tags 0x200
+   unlocked and 0x201 locked. The saving is signed; on a core where
+   the registers are not implemented it is the cost of writing them.
+   Stream points end with the PCU counts of the run on cores with
+   performance counters (see bench.h). Hot line points time HOT_CALLS
+   separate regions and report no counts.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+#include "cache.h"
+
+#define PREFETCH_SIZE	(64 << 10)
+
+#define HOT_LINES	8
+#define HOT_CALLS	64
+
+extern char end;
+
+static const unsigned long distances[] = { 0, 1, 2, 4, 8 };
+
+/* Keeps the sums from being optimised away */
+volatile unsigned long prefetch_sink;
+
+static unsigned long
+stream_time(const unsigned long *buf, unsigned long line,
+	    unsigned long distance)
+{
+  unsigned long words = line / 4, ahead = distance * line;
+  unsigned long i, j, sum = 0, start, cycles;
+
+  dcache_flush_range((void *) buf, PREFETCH_SIZE);
+
+  pcu_start();
+  start = bench_timer_read();
+  for (i = 0; i < PREFETCH_SIZE / 4; i += words)
+    {
+      if (distance)
+	mtspr(SPR_DCBPR, (unsigned long) &buf[i] + ahead);
+      for (j = 0; j < words; j++)
+	sum += buf[i + j];
+    }
+  cycles = bench_timer_read() - start;
+  pcu_stop();
+
+  prefetch_sink = sum;
+
+  return cycles;
+}
+
+/* Fill code with l.nop and a return at the end */
+static void
+code_write(char *code, unsigned long size)
+{
+  unsigned long *insn = (unsigned long *) code;
+  unsigned long i;
+
+  for (i = 0; i < size / 4; i++)
+    insn[i] = OR32_L_NOP;
+  insn[size / 4 - 2] = OR32_L_JR_R9;
+
+  dcache_flush_range(code, size);
+  icache_inval_range(code, size);
+}
+
+static unsigned long
+hot_time(char *code, const unsigned long *data, unsigned long iline,
+	 unsigned long dline, const char *istorm, unsigned long isize,
+	 const char *dstorm, unsigned long dsize)
+{
+  unsigned long i, j, sum = 0, start, cycles = 0;
+
+  for (i = 0; i < HOT_CALLS; i++)
+    {
+      for (j = 0; j < isize; j += iline)
+	((void (*) (void)) (istorm + j)) ();
+      for (j = 0; j < dsize; j += dline)
+	sum += *(volatile const unsigned long *) (dstorm + j);
+
+      start = bench_timer_read();
+      ((void (*) (void)) code) ();
+      for (j = 0; j < HOT_LINES * dline / 4; j += dline / 4)
+	sum += data[j];
+      cycles += bench_timer_read() - start;
+    }
+
+  prefetch_sink = sum;
+
+  return cycles;
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr = mfspr(SPR_DCCFGR), iccfgr = mfspr(SPR_ICCFGR);
+  unsigned long dline = cache_line(dccfgr), iline = cache_line(iccfgr);
+  unsigned long dsize = 2 * cache_size(dccfgr);
+  unsigned long isize = 2 * cache_size(iccfgr);
+  unsigned long i, cycles, base = 0;
+  /* Start the buffers on a 64 KiB boundary past the image */
+  unsigned long *buf = (unsigned long *)
+    (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *istorm = (char *) buf + PREFETCH_SIZE;
+  char *dstorm = istorm + isize;
+  char *code = dstorm + dsize;
+  unsigned long *data = (unsigned long *) (code + HOT_LINES * iline);
+
+  report(BENCH_TAG(BENCH_ID_PREFETCH, 0));
+  report(dccfgr);
+  report(iccfgr);
+
+  for (i = 0; i < PREFETCH_SIZE / 4; i++)
+    buf[i] = i;
+
+  /* Return stubs at the start of every instruction cache line */
+  for (i = 0; i < isize; i += iline)
+    {
+      ((unsigned long *) (istorm + i))[0] = OR32_L_JR_R9;
+      ((unsigned long *) (istorm + i))[1] = OR32_L_NOP;
+    }
+  dcache_flush_range(istorm, isize);
+  icache_inval_range(istorm, isize);
+  code_write(code, HOT_LINES * iline);
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  for (i = 0; i < sizeof(distances) / sizeof(distances[0]); i++)
+    {
+      cycles = stream_time(buf, dline, distances[i]);
+      if (!distances[i])
+	base = cycles;
+
+      report(BENCH_TAG(BENCH_ID_PREFETCH, 0x100 | distances[i]));
+      report(distances[i]);
+      report(cycles);
+      report(base - cycles);
+      bench_pcu_report();
+    }
+
+  base = hot_time(code, data, iline, dline, istorm, isize, dstorm, dsize);
+  report(BENCH_TAG(BENCH_ID_PREFETCH, 0x200));
+  report(0);
+  report(base);
+  report(0);
+
+  for (i = 0; i < HOT_LINES; i++)
+    {
+      mtspr(SPR_ICBLR, (unsigned long) code + i * iline);
+      mtspr(SPR_DCBLR, (unsigned long) data + i * dline);
+    }
+  cycles = hot_time(code, data, iline, dline, istorm, isize, dstorm, dsize);
+  icache_inval_range(code, HOT_LINES * iline);
+  dcache_flush_range(data, HOT_LINES * dline);
+
+  report(BENCH_TAG(BENCH_ID_PREFETCH, 0x201));
+  report(1);
+  report(cycles);
+  report(base - cycles);
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+   Formatted output benchmark
+
+   Times single calls of newlib stdio against the libsupport tprintf.h
+   routines, each line drained to its sink within the call:
+     1 "%d\n"
+     2 "0x%08x\n"
+     3 "%s\n"
+     4 "%s %d 0x%x\n"
+     5 putchar('\n') against tputchar('\n')
+   for newlib printf() and putchar(), for tprintf() to l.nop NOP_PUTC,
+   its default, and for tprintf() to the 16550 at UART0_BASE, as on an
+   FPGA. Every case runs PRINTF_WARMUP times untimed, which also lets
+   newlib set up stdout, then PRINTF_REPS times through timer_bench().
+
+   Reports under tag 0:
+     cycle source, timer_overhead (see timer.h)
+   then for every case the tag followed by:
+     repetitions, min, median and max cycles per call
+   Tags are 0xLC, L 1 newlib, 2 tprintf to NOP_PUTC and 3 tprintf to
+   UART0, and C the case above. No PCU counts are reported, the
+   statistics come from PRINTF_REPS separately timed calls.
+*/
+
+#include <stdio.h>
+#include "bench.h"
+#include "board.h"
+#include "timer.h"
+#include "tprintf.h"
+
+#define PRINTF_CASES	5
+#define PRINTF_WARMUP	2
+#define PRINTF_REPS	16
+
+static void newlib_case(void *arg)
+{
+  switch ((unsigned long) arg)
+    {
+    case 1: printf("%d\n", 123456); break;
+    case 2: printf("0x%08x\n", 0xbeef); break;
+    case 3: printf("%s\n", "or1k"); break;
+    case 4: printf("%s %d 0x%x\n", "or1k", -42, 0xcafe); break;
+    case 5: putchar('\n'); break;
+    }
+}
+
+static void tprintf_case(void *arg)
+{
+  switch ((unsigned long) arg)
+    {
+    case 1: tprintf("%d\n", 123456); break;
+    case 2: tprintf("0x%08x\n", 0xbeef); break;
+    case 3: tprintf("%s\n", "or1k"); break;
+    case 4: tprintf("%s %d 0x%x\n", "or1k", -42, 0xcafe); break;
+    case 5: tputchar('\n'); break;
+    }
+}
+
+static void
+printf_run(unsigned int lib, void (*fn) (void *))
+{
+  unsigned long samples[PRINTF_REPS];
+  struct timer_stats stats;
+  unsigned long c;
+
+  for (c = 1; c <= PRINTF_CASES; c++)
+    {
+      timer_bench(fn, (void *) c, PRINTF_WARMUP, PRINTF_REPS, samples,
+		  &stats);
+      fflush(stdout);
+
+      report(BENCH_TAG(BENCH_ID_PRINTF, (lib << 4) | c));
+      report(PRINTF_REPS);
+      report(stats.min);
+      report(stats.median);
+      report(stats.max);
+    }
+}
+
+int
+main(void)
+{
+  report(BENCH_TAG(BENCH_ID_PRINTF, 0));
+  report(timer_init());
+  report(timer_overhead);
+
+  printf_run(1, newlib_case);
+  printf_run(2, tprintf_case);
+
+  tprint_init_uart0();
+  printf_run(3, tprintf_case);
+
+  report(0x8000000d);
+
+  return 0;
+}
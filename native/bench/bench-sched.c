@@ -0,0 +1,112 @@
+/*
+   Context switch benchmark
+
+   Runs 2, 4, 8 and 16 tasks under the libsupport round robin
+   scheduler (see sched.h) with a SCHED_PERIOD tick time slice, next to
+   main which waits for SCHED_ROUNDS trips round the ring. Each task
+   spins reading TTCR; as the timer restarts from 0 on every tick, the
+   first value a task reads after being resumed is the time from the
+   tick to the task running again, i.e. the interrupt entry, the
+   context switch and one loop iteration.
+
+   For every task count reports the tag followed by:
+     tasks, switches, loop iterations of all tasks, min, average and
+     max resume latency
+   Tags are the task count. The min is the switch cost, max - min the
+   scheduling jitter. No PCU counts are reported, the latencies are
+   TTCR values read by the tasks rather than timed regions.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+#include "sched.h"
+
+#define SCHED_MAX_TASKS	16
+#define SCHED_STACK	1024
+#define SCHED_PERIOD	2048
+#define SCHED_ROUNDS	32
+
+struct task_stats
+{
+  unsigned long work;
+  unsigned long resumes;
+  unsigned long sum;
+  unsigned long min;
+  unsigned long max;
+};
+
+static struct sched_task main_task;
+static struct sched_task tasks[SCHED_MAX_TASKS];
+static unsigned long stacks[SCHED_MAX_TASKS][SCHED_STACK / 4];
+static struct task_stats stats[SCHED_MAX_TASKS];
+
+static void
+task_fn(void *arg)
+{
+  volatile struct task_stats *s = arg;
+  unsigned long now, prev = mfspr(SPR_TTCR);
+
+  while (1)
+    {
+      now = mfspr(SPR_TTCR);
+      if (now < prev)
+	{
+	  s->resumes++;
+	  s->sum += now;
+	  if (now < s->min)
+	    s->min = now;
+	  if (now > s->max)
+	    s->max = now;
+	}
+      prev = now;
+      s->work++;
+    }
+}
+
+int
+main(void)
+{
+  unsigned long n, i, work, resumes, sum, min, max;
+
+  for (n = 2; n <= SCHED_MAX_TASKS; n <<= 1)
+    {
+      sched_init(&main_task);
+      for (i = 0; i < n; i++)
+	{
+	  stats[i].work = stats[i].resumes = stats[i].sum = 0;
+	  stats[i].min = ~0UL;
+	  stats[i].max = 0;
+	  sched_add(&tasks[i], task_fn, &stats[i], stacks[i], SCHED_STACK);
+	}
+
+      sched_start(SCHED_PERIOD);
+      while (SCHED_VAR(SCHED_SWITCHES) < (n + 1) * SCHED_ROUNDS)
+	;
+      sched_stop();
+
+      work = resumes = sum = max = 0;
+      min = ~0UL;
+      for (i = 0; i < n; i++)
+	{
+	  work += stats[i].work;
+	  resumes += stats[i].resumes;
+	  sum += stats[i].sum;
+	  if (stats[i].min < min)
+	    min = stats[i].min;
+	  if (stats[i].max > max)
+	    max = stats[i].max;
+	}
+
+      report(BENCH_TAG(BENCH_ID_SCHED, n));
+      report(n);
+      report(SCHED_VAR(SCHED_SWITCHES));
+      report(work);
+      report(min);
+      report(resumes ? sum / resumes : 0);
+      report(max);
+    }
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*
+   STREAM style memory bandwidth benchmark
+
+   Runs the four STREAM kernels over word, halfword and byte arrays:
+     copy   c[i] = a[i]
+     scale  b[i] = q * c[i]
+     add    c[i] = a[i] + b[i]
+     triad  a[i] = b[i] + q * c[i]
+   Two array sizes are used, one where all three arrays fit in the data
+   cache together and one STREAM_LARGE_FACTOR times the cache size (or
+   STREAM_NODC_SIZE bytes without a data cache) per array. The arrays
+   are staggered by the small size, so in the small case they sit on
+   different sets of a direct mapped cache rather than contending for
+   the same ones. Each kernel runs once untimed, then once timed.
+
+   The Makefile builds this file with -fno-tree-loop-distribute-patterns
+   so GCC does not turn the copy loops into memcpy() calls, which would
+   time newlib instead of loads and stores of the element width.
+
+   For every run reports the tag followed by:
+     bytes per array, bytes moved, cycles, bytes per cycle (8.8 fixed
+     point)
+   Tags are 0xSTK, S the size (1 small, 2 large), T the element width in
+   bytes and K the kernel (1 copy, 2 scale, 3 add, 4 triad). Bytes moved
+   count reads and writes the way STREAM does.
+
+   Under or1ksim the effect of memory timing can be seen by changing
+   delayr/delayw in the memory section of sim.cfg.
+*/
+
+#include <stdint.h>
+#include "spr-defs.h"
+#include "bench.h"
+
+#define STREAM_LARGE_FACTOR	8
+#define STREAM_NODC_SIZE	(64 << 10)
+#define STREAM_MAX_SIZE		(1 << 20)
+
+#define STREAM_SCALAR		3
+
+extern char end;
+
+#define STREAM_KERNELS(type)						\
+static void								\
+copy_##type(void *va, void *vb, void *vc, unsigned long n)		\
+{									\
+  type *a = va, *c = vc;						\
+  unsigned long i;							\
+  for (i = 0; i < n; i++)						\
+    c[i] = a[i];							\
+}									\
+									\
+static void								\
+scale_##type(void *va, void *vb, void *vc, unsigned long n)		\
+{									\
+  type *b = vb, *c = vc;						\
+  unsigned long i;							\
+  for (i = 0; i < n; i++)						\
+    b[i] = STREAM_SCALAR * c[i];					\
+}									\
+									\
+static void								\
+add_##type(void *va, void *vb, void *vc, unsigned long n)		\
+{									\
+  type *a = va, *b = vb, *c = vc;					\
+  unsigned long i;							\
+  for (i = 0; i < n; i++)						\
+    c[i] = a[i] + b[i];							\
+}									\
+									\
+static void								\
+triad_##type(void *va, void *vb, void *vc, unsigned long n)		\
+{									\
+  type *a = va, *b = vb, *c = vc;					\
+  unsigned long i;							\
+  for (i = 0; i < n; i++)						\
+    a[i] = b[i] + STREAM_SCALAR * c[i];					\
+}
+
+STREAM_KERNELS(uint32_t)
+STREAM_KERNELS(uint16_t)
+STREAM_KERNELS(uint8_t)
+
+typedef void (*stream_fn) (void *a, void *b, void *c, unsigned long n);
+
+struct stream_type
+{
+  unsigned long width;
+  stream_fn kernel[4];
+};
+
+static const struct stream_type stream_types[] =
+{
+  { 4, { copy_uint32_t, scale_uint32_t, add_uint32_t, triad_uint32_t } },
+  { 2, { copy_uint16_t, scale_uint16_t, add_uint16_t, triad_uint16_t } },
+  { 1, { copy_uint8_t, scale_uint8_t, add_uint8_t, triad_uint8_t } },
+};
+
+/* Arrays read and written by each kernel, as counted by STREAM */
+static const unsigned long stream_arrays[4] = { 2, 2, 3, 3 };
+
+static void
+stream_run(unsigned int s, unsigned long size, char *a, char *b, char *c)
+{
+  const struct stream_type *t;
+  unsigned long start, cycles, bytes, n;
+  unsigned int k;
+
+  for (t = stream_types; t < stream_types + 3; t++)
+    {
+      n = size / t->width;
+      for (k = 0; k < 4; k++)
+	{
+	  t->kernel[k](a, b, c, n);
+
+	  pcu_start();
+	  start = bench_timer_read();
+	  t->kernel[k](a, b, c, n);
+	  cycles = bench_timer_read() - start;
+	  pcu_stop();
+
+	  bytes = stream_arrays[k] * size;
+
+	  report(BENCH_TAG(BENCH_ID_STREAM, (s << 8) | (t->width << 4) | (k + 1)));
+	  report(size);
+	  report(bytes);
+	  report(cycles);
+	  report((bytes << 8) / cycles);
+	  bench_pcu_report();
+	}
+    }
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr, dc_size, large, small, i;
+  char *a = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *b, *c;
+
+  if (mfspr(SPR_UPR) & SPR_UPR_DCP)
+    {
+      dccfgr = mfspr(SPR_DCCFGR);
+      dc_size = (16 << ((dccfgr & SPR_DCCFGR_CBS) >> SPR_DCCFGR_CBS_OFF)) *
+	(1 << ((dccfgr & SPR_DCCFGR_NCS) >> SPR_DCCFGR_NCS_OFF)) *
+	(1 << ((dccfgr & SPR_DCCFGR_NCW) >> SPR_DCCFGR_NCW_OFF));
+      small = dc_size / 4;
+      large = STREAM_LARGE_FACTOR * dc_size;
+    }
+  else
+    {
+      small = STREAM_NODC_SIZE / 16;
+      large = STREAM_NODC_SIZE;
+    }
+
+  if (large > STREAM_MAX_SIZE)
+    large = STREAM_MAX_SIZE;
+
+  b = a + large + small;
+  c = b + large + small;
+
+  for (i = 0; i < large; i++)
+    {
+      a[i] = i;
+      b[i] = i * 5;
+      c[i] = i * 7;
+    }
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  stream_run(1, small, a, b, c);
+  stream_run(2, large, a, b, c);
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+   Tick interrupt storm benchmark
+
+   Timing counterpart of or1k-tickloop.S and or1k-inttickloop.S. Runs
+   the tick timer in restart mode with periods from STORM_MAX_PERIOD
+   down to STORM_MIN_PERIOD cycles, halving each time, and counts how
+   many iterations of a polling loop complete during STORM_TICKS
+   interrupts. The handler is jumped to straight from the patched 0x500
+   vector (see vector.h) and only counts the tick, it stops the timer
+   after the last one so the loop always finishes even once the
+   handler no longer leaves it any time.
+
+   The time each period takes is measured rather than assumed to be
+   STORM_TICKS periods, as a handler slower than the period drops the
+   ticks that come due while it runs. Under or1ksim it is the
+   simulator cycle count (see timer.h), which leaves the tick timer to
+   the storm. Otherwise, TTCR being taken, it is STORM_TICKS periods
+   plus the TTCR seen on entry to the last handler, which misses any
+   dropped ticks and so is a lower bound once the storm livelocks.
+
+   The longest period is the reference: its cycles per iteration are
+   taken as the cost of the loop alone, and whatever a shorter period
+   loses against it is charged to the interrupts.
+
+   Reports under tag 0:
+     cycle source, TIMER_SIM when measured by the simulator
+   then for every period the tag followed by:
+     period, interrupts, loop iterations, cycles, iterations per cycle
+     (8.8 fixed point), cycles per interrupt
+   Tags are log2 of the period. Iterations dropping to 0 marks the
+   livelock threshold, cycles per interrupt then reach the period and
+   go past it as ticks get dropped. No PCU counts are reported, the
+   interrupt cost is derived from the loop rather than counted.
+*/
+
+#include "spr-defs.h"
+#include "bench.h"
+#include "timer.h"
+#include "vector.h"
+
+#define STORM_TICKS		32
+#define STORM_MAX_PERIOD	65536
+#define STORM_MIN_PERIOD	4
+
+#define TICK_VECTOR		0x500
+
+/* Handler scratch words relative to r0, after the ones in tlbrefill.h
+   and sched.h */
+#define STORM_SAVE_R3		0x40
+#define STORM_SAVE_R4		0x44
+#define STORM_COUNT		0x48
+#define STORM_TTMR		0x4c
+#define STORM_ENTRY		0x60	/* TTCR on entry to the last handler */
+
+#define STORM_VAR(off)		(*(volatile unsigned long *) (off))
+
+#define STR(x)	#x
+#define XSTR(x)	STR(x)
+
+void storm_tick_handler(void);
+
+/* The l.nop after l.bf fills the delay slot on delay slot builds and is
+   harmless on the fall through path otherwise */
+asm(
+"	.global	storm_tick_handler\n"
+"	.type	storm_tick_handler,@function\n"
+"storm_tick_handler:\n"
+"	l.sw	" XSTR(STORM_SAVE_R3) "(r0), r3\n"
+"	l.sw	" XSTR(STORM_SAVE_R4) "(r0), r4\n"
+"	l.mfspr	r4, r0, " XSTR(SPR_TTCR) "\n"
+"	l.sw	" XSTR(STORM_ENTRY) "(r0), r4\n"
+"	l.lwz	r3, " XSTR(STORM_COUNT) "(r0)\n"
+"	l.addi	r3, r3, 1\n"
+"	l.sw	" XSTR(STORM_COUNT) "(r0), r3\n"
+"	l.sfltui r3, " XSTR(STORM_TICKS) "\n"
+"	l.lwz	r4, " XSTR(STORM_TTMR) "(r0)\n"
+"	l.bf	1f\n"
+"	l.nop\n"
+"	l.or	r4, r0, r0\n"
+"1:\n"
+"	l.mtspr	r0, r4, " XSTR(SPR_TTMR) "\n"
+"	l.lwz	r3, " XSTR(STORM_SAVE_R3) "(r0)\n"
+"	l.lwz	r4, " XSTR(STORM_SAVE_R4) "(r0)\n"
+"	l.rfe\n");
+
+static unsigned long
+storm_loop(void)
+{
+  unsigned long work = 0;
+
+  while (STORM_VAR(STORM_COUNT) < STORM_TICKS)
+    work++;
+
+  return work;
+}
+
+int
+main(void)
+{
+  unsigned long saved[VECTOR_PATCH_WORDS];
+  unsigned long period, log2p, work, cycles, loop, ref_cpw = 0;
+  unsigned long src, start = 0;
+
+  /* Before the storm takes the tick timer, a TTCR source is unusable */
+  src = timer_init();
+  report(BENCH_TAG(BENCH_ID_TICKSTORM, 0));
+  report(src);
+
+  vector_patch(TICK_VECTOR, storm_tick_handler, saved);
+  mtspr(SPR_SR, mfspr(SPR_SR) | SPR_SR_TEE);
+
+  log2p = 0;
+  for (period = STORM_MAX_PERIOD; period > 1; period >>= 1)
+    log2p++;
+
+  for (period = STORM_MAX_PERIOD; period >= STORM_MIN_PERIOD;
+       period >>= 1, log2p--)
+    {
+      STORM_VAR(STORM_COUNT) = 0;
+      STORM_VAR(STORM_TTMR) = SPR_TTMR_RT | SPR_TTMR_IE | period;
+
+      if (src == TIMER_SIM)
+	start = cycles_now();
+      mtspr(SPR_TTCR, 0);
+      mtspr(SPR_TTMR, STORM_VAR(STORM_TTMR));
+      work = storm_loop();
+
+      if (src == TIMER_SIM)
+	cycles = cycles_elapsed(start);
+      else
+	cycles = STORM_TICKS * period + STORM_VAR(STORM_ENTRY);
+      if (period == STORM_MAX_PERIOD)
+	ref_cpw = (cycles << 8) / (work ? work : 1);
+
+      /* Cycles the loop iterations would take without interrupts */
+      loop = (work * ref_cpw) >> 8;
+
+      report(BENCH_TAG(BENCH_ID_TICKSTORM, log2p));
+      report(period);
+      report(STORM_TICKS);
+      report(work);
+      report(cycles);
+      report((work << 8) / cycles);
+      report(cycles > loop ? (cycles - loop) / STORM_TICKS : 0);
+    }
+
+  mtspr(SPR_SR, mfspr(SPR_SR) & ~SPR_SR_TEE);
+  vector_restore(TICK_VECTOR, saved);
+
+  report(0x8000000d);
+
+  return 0;
+}
@@ -0,0 +1,249 @@
+/*
+   TLB reach and miss cost benchmark
+
+   Walks 1 to TLB_MAX_FACTOR times as many 8 KiB pages as the TLB has
+   entries, one access per page, with the DMMU (data walk) or the IMMU
+   (instruction walk, calling an l.jr r9 stub in each page) enabled
+   and every page mapped one to one by a miss handler. Each point runs
+   TLB_PASSES passes after an untimed pass that fills the TLB, and the
+   same walk is timed with the MMU off as the baseline.
+
+   Three refill paths are compared:
+     1 a C handler registered with or1k_exception_handler_add()
+     2 the libsupport assembly handler jumped to straight from the
+       patched vector (see tlbrefill.h)
+     3 the libsupport page table walker (see pgtable.h) with all of RAM
+       mapped one to one through map_range()
+   All write the same entry, so 1 against 2 is the cost of the newlib
+   exception dispatch and 3 against 2 the cost of the table walk.
+
+   Reports tag 0 followed by the DTLB sets and ways and the ITLB sets
+   and ways, then for every point the tag followed by:
+     pages, accesses, cycles, baseline cycles, refills,
+     cycles per access (8.8 fixed point), cycles per refill
+   Tags are 0xHSNN, H the handler, S the walk (1 data, 2 instruction)
+   and NN log2 of the page count. Once the page count passes the TLB
+   size every access misses and cycles per refill is the miss cost.
+*/
+
+#include <or1k-support.h>
+#include "spr-defs.h"
+#include "bench.h"
+#include "cache.h"
+#include "tlbrefill.h"
+#include "pgtable.h"
+#include "vector.h"
+
+#define TLB_PASSES	16
+#define TLB_MAX_FACTOR	4
+/* Each walk covers at most 2 MiB, the two fit in the default 8 MiB of
+   or1ksim RAM below the stack */
+#define TLB_MAX_PAGES	256
+
+/* Accesses move down a cache line per page so they do not all land in
+   the same data or instruction cache set */
+#define TLB_LINE	32
+
+#define DTLB_VECTOR	0x900
+#define ITLB_VECTOR	0xa00
+
+extern char end;
+extern unsigned long _or1k_board_mem_base;
+extern unsigned long _or1k_board_mem_size;
+
+struct tlb_walk
+{
+  unsigned int id;
+  unsigned long count;
+  void (*enable) (void);
+  void (*disable) (void);
+  void (*walk) (char *base, unsigned long pages);
+};
+
+static inline char *
+page_addr(char *base, unsigned long i)
+{
+  return base + (i << TLB_REFILL_PAGE_SHIFT) +
+    ((i * TLB_LINE) & (TLB_REFILL_PAGE_SIZE - 1));
+}
+
+static void
+data_walk(char *base, unsigned long pages)
+{
+  unsigned long pass, i;
+
+  for (pass = 0; pass < TLB_PASSES; pass++)
+    for (i = 0; i < pages; i++)
+      (void) *(volatile unsigned long *) page_addr(base, i);
+}
+
+static void
+insn_walk(char *base, unsigned long pages)
+{
+  unsigned long pass, i;
+
+  for (pass = 0; pass < TLB_PASSES; pass++)
+    for (i = 0; i < pages; i++)
+      ((void (*) (void)) page_addr(base, i)) ();
+}
+
+/* C refill, the same entry tlb_refill_dtlb_miss writes */
+static void
+dtlb_miss_handler(void)
+{
+  unsigned long ea = mfspr(SPR_EEAR_BASE);
+  unsigned long way = tlb_refill_next_way(TLB_REFILL_DNEXT,
+					  TLB_REFILL_DWAYS);
+  unsigned long spr = (way << 8) +
+    ((ea >> TLB_REFILL_PAGE_SHIFT) & TLB_REFILL_VAR(TLB_REFILL_DSETS));
+
+  TLB_REFILL_VAR(TLB_REFILL_DCOUNT)++;
+  mtspr(SPR_DTLBMR_BASE(0) + spr, (ea & SPR_DTLBMR_VPN) | SPR_DTLBMR_V);
+  mtspr(SPR_DTLBTR_BASE(0) + spr, (ea & SPR_DTLBTR_PPN) | TLB_REFILL_DTLB_PR);
+}
+
+static void
+itlb_miss_handler(void)
+{
+  unsigned long ea = mfspr(SPR_EEAR_BASE);
+  unsigned long way = tlb_refill_next_way(TLB_REFILL_INEXT,
+					  TLB_REFILL_IWAYS);
+  unsigned long spr = (way << 8) +
+    ((ea >> TLB_REFILL_PAGE_SHIFT) & TLB_REFILL_VAR(TLB_REFILL_ISETS));
+
+  TLB_REFILL_VAR(TLB_REFILL_ICOUNT)++;
+  mtspr(SPR_ITLBMR_BASE(0) + spr, (ea & SPR_ITLBMR_VPN) | SPR_ITLBMR_V);
+  mtspr(SPR_ITLBTR_BASE(0) + spr, (ea & SPR_ITLBTR_PPN) | TLB_REFILL_ITLB_PR);
+}
+
+static void
+tlb_run(const struct tlb_walk *w, unsigned int handler, char *base,
+	unsigned long max_pages)
+{
+  unsigned long pages, log2n, start, cycles, baseline, refills, accesses;
+
+  for (log2n = 0, pages = 1; pages <= max_pages; log2n++, pages <<= 1)
+    {
+      w->walk(base, pages);
+      start = bench_timer_read();
+      w->walk(base, pages);
+      baseline = bench_timer_read() - start;
+
+      tlb_refill_init();
+      w->enable();
+      w->walk(base, pages);
+      TLB_REFILL_VAR(w->count) = 0;
+
+      pcu_start();
+      start = bench_timer_read();
+      w->walk(base, pages);
+      cycles = bench_timer_read() - start;
+      pcu_stop();
+
+      refills = TLB_REFILL_VAR(w->count);
+      w->disable();
+
+      accesses = pages * TLB_PASSES;
+
+      report(BENCH_TAG(BENCH_ID_TLB, (handler << 12) | (w->id << 8) | log2n));
+      report(pages);
+      report(accesses);
+      report(cycles);
+      report(baseline);
+      report(refills);
+      report((cycles << 8) / accesses);
+      report(refills && cycles > baseline ? (cycles - baseline) / refills : 0);
+      bench_pcu_report();
+    }
+}
+
+static const struct tlb_walk dtlb_walk =
+  { 1, TLB_REFILL_DCOUNT, or1k_dmmu_enable, or1k_dmmu_disable, data_walk };
+static const struct tlb_walk itlb_walk =
+  { 2, TLB_REFILL_ICOUNT, or1k_immu_enable, or1k_immu_disable, insn_walk };
+
+static unsigned long
+tlb_max_pages(unsigned long cfgr)
+{
+  unsigned long sets = 1 << ((cfgr & SPR_DMMUCFGR_NTS) >> SPR_DMMUCFGR_NTS_OFF);
+  unsigned long ways = 1 + ((cfgr & SPR_DMMUCFGR_NTW) >> SPR_DMMUCFGR_NTW_OFF);
+  unsigned long pages = TLB_MAX_FACTOR * sets * ways;
+
+  return pages > TLB_MAX_PAGES ? TLB_MAX_PAGES : pages;
+}
+
+int
+main(void)
+{
+  char *dbase = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *ibase = dbase + TLB_MAX_PAGES * TLB_REFILL_PAGE_SIZE;
+  char *pool = ibase + TLB_MAX_PAGES * TLB_REFILL_PAGE_SIZE;
+  unsigned long pool_size = PGTABLE_PGD_SIZE + PGTABLE_PTE_SIZE *
+    ((_or1k_board_mem_size >> PGTABLE_PGD_SHIFT) + 1);
+  unsigned long upr = mfspr(SPR_UPR);
+  unsigned long dcfgr = mfspr(SPR_DMMUCFGR), icfgr = mfspr(SPR_IMMUCFGR);
+  unsigned long dsaved[VECTOR_PATCH_WORDS], isaved[VECTOR_PATCH_WORDS];
+  unsigned long i;
+  char *stub;
+
+  report(BENCH_TAG(BENCH_ID_TLB, 0));
+  report(1 << ((dcfgr & SPR_DMMUCFGR_NTS) >> SPR_DMMUCFGR_NTS_OFF));
+  report(1 + ((dcfgr & SPR_DMMUCFGR_NTW) >> SPR_DMMUCFGR_NTW_OFF));
+  report(1 << ((icfgr & SPR_IMMUCFGR_NTS) >> SPR_IMMUCFGR_NTS_OFF));
+  report(1 + ((icfgr & SPR_IMMUCFGR_NTW) >> SPR_IMMUCFGR_NTW_OFF));
+
+  /* Return stubs for the instruction walk */
+  for (i = 0; i < TLB_MAX_PAGES; i++)
+    {
+      stub = page_addr(ibase, i);
+      ((unsigned long *) stub)[0] = OR32_L_JR_R9;
+      ((unsigned long *) stub)[1] = OR32_L_NOP;
+      mtspr(SPR_DCBFR, (unsigned long) stub);
+      mtspr(SPR_ICBIR, (unsigned long) stub);
+    }
+
+  bench_timer_start();
+  bench_pcu_setup();
+
+  or1k_exception_handler_add(0x9, dtlb_miss_handler);
+  or1k_exception_handler_add(0xa, itlb_miss_handler);
+
+  if (upr & SPR_UPR_DMP)
+    tlb_run(&dtlb_walk, 1, dbase, tlb_max_pages(dcfgr));
+  if (upr & SPR_UPR_IMP)
+    tlb_run(&itlb_walk, 1, ibase, tlb_max_pages(icfgr));
+
+  vector_patch(DTLB_VECTOR, tlb_refill_dtlb_miss, dsaved);
+  vector_patch(ITLB_VECTOR, tlb_refill_itlb_miss, isaved);
+
+  if (upr & SPR_UPR_DMP)
+    tlb_run(&dtlb_walk, 2, dbase, tlb_max_pages(dcfgr));
+  if (upr & SPR_UPR_IMP)
+    tlb_run(&itlb_walk, 2, ibase, tlb_max_pages(icfgr));
+
+  vector_restore(DTLB_VECTOR, dsaved);
+  vector_restore(ITLB_VECTOR, isaved);
+
+  if (pgtable_init(pool, pool_size) ||
+      map_range(_or1k_board_mem_base, _or1k_board_mem_base,
+		_or1k_board_mem_size, PGTABLE_RWX))
+    {
+      report(0xbaaaaaad);
+      return 1;
+    }
+
+  vector_patch(DTLB_VECTOR, pgtable_dtlb_miss, dsaved);
+  vector_patch(ITLB_VECTOR, pgtable_itlb_miss, isaved);
+
+  if (upr & SPR_UPR_DMP)
+    tlb_run(&dtlb_walk, 3, dbase, tlb_max_pages(dcfgr));
+  if (upr & SPR_UPR_IMP)
+    tlb_run(&itlb_walk, 3, ibase, tlb_max_pages(icfgr));
+
+  vector_restore(DTLB_VECTOR, dsaved);
+  vector_restore(ITLB_VECTOR, isaved);
+
+  report(0x8000000d);
+
+  return 0;
+}
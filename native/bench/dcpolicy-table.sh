@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# SYNOPSIS
+#  dcpolicy-table.sh <label>=<log> [<label>=<log> ...]
+#
+# SUMMARY
+#
+# Prints the bench-dcpolicy cycles of several runs side by side, one
+# row per workload, followed by the bus transactions each run modelled
+# for its write policy, e.g.
+#
+#  dcpolicy-table.sh wb=dcwb.log wt=dcwt.log
+#
+# The logs are the simulator or testbench output holding the
+# report(0x...) lines of one bench-dcpolicy run each. The "model bus"
+# columns are arithmetic on the access pattern, not measured traffic,
+# and only follow the policy each run assumed, printed in the model row
+# next to its DCCFGR[CWS]; build with DCPOLICY_WB=1 for sim-dcwb.cfg
+# runs, as or1ksim always reports write through.
+
+if [ $# -eq 0 ] ; then
+  echo "usage: $0 <label>=<log> ..." >&2
+  exit 1
+fi
+
+for run in "$@" ; do
+  label=${run%%=*}
+  log=${run#*=}
+  # One "label workload cycles transactions" line per workload, and
+  # "label 0 cws model" for tag 0
+  sed -n 's/.*report *(0x\([0-9a-fA-F]*\)).*/\1/p' $log | awk -v label=$label '
+    function hex(s,  i, r) {
+      r = 0
+      for (i = 1; i <= length(s); i++)
+        r = r * 16 + index("0123456789abcdef", substr(s, i, 1)) - 1
+      return r
+    }
+    BEGIN { n = -1 }
+    { v = tolower($1) }
+    v ~ /^be12/ { n = hex(substr(v, 5)); i = 0; next }
+    n >= 0 { i++ }
+    n == 0 && i == 1 { cws = hex(v) }
+    n == 0 && i == 2 { print label, 0, cws, hex(v); n = -1 }
+    n > 0 && i == 2 { cycles = hex(v) }
+    n > 0 && i == 5 { print label, n, cycles, hex(v); n = -1 }'
+done | awk '
+  BEGIN {
+    name[1] = "fill"; name[2] = "rmw"; name[3] = "mixed"; name[4] = "dma"
+  }
+  !($1 in seen) { seen[$1] = 1; labels[++nl] = $1 }
+  { cycles[$1, $2] = $3; bus[$1, $2] = $4 }
+  END {
+    printf "%-8s", "workload"
+    for (l = 1; l <= nl; l++)
+      printf " %14s", labels[l] " cycles"
+    for (l = 1; l <= nl; l++)
+      printf " %14s", labels[l] " model bus"
+    printf "\n"
+    printf "%-8s", "model"
+    for (l = 1; l <= nl; l++)
+      printf " %14s", "cws " cycles[labels[l], 0]
+    for (l = 1; l <= nl; l++) {
+      model = bus[labels[l], 0] ? "wb" : "wt"
+      printf " %14s", model
+    }
+    printf "\n"
+    for (n = 1; n <= 4; n++) {
+      printf "%-8s", name[n]
+      for (l = 1; l <= nl; l++)
+        printf " %14s", cycles[labels[l], n]
+      for (l = 1; l <= nl; l++)
+        printf " %14s", bus[labels[l], n]
+      printf "\n"
+    }
+    printf "model bus: modelled from the access pattern, not measured\n"
+  }'
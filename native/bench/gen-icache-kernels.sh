@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+# SYNOPSIS
+#  gen-icache-kernels.sh [max_size] > icache-kernels.S
+#
+# SUMMARY
+#
+# Generates the code footprint kernels used by bench-icache.c. For every
+# power of two from 256 bytes up to max_size (default 65536) emits a kernel
+# icache_<size> with <size> bytes of independent l.addi instructions inside
+# a loop counting down r3, plus the icache_kernels table of
+# { size, kernel } pairs terminated by a zero size.
+#
+# The kernels follow the C calling convention and only touch caller saved
+# registers.
+
+MAX_SIZE=${1:-65536}
+
+cat <<HEADER
+/* Generated by gen-icache-kernels.sh, do not edit */
+#include <or1k-asm.h>
+#include "bench.h"
+
+	.section .text
+HEADER
+
+size=256
+while [ $size -le $MAX_SIZE ] ; do
+  cat <<KERNEL
+
+	.global	icache_$size
+	.type	icache_$size,@function
+	.balign	64
+icache_$size:
+1:
+	.rept	$size / 32
+	l.addi	r13, r13, 1
+	l.addi	r15, r15, 1
+	l.addi	r17, r17, 1
+	l.addi	r19, r19, 1
+	l.addi	r21, r21, 1
+	l.addi	r23, r23, 1
+	l.addi	r25, r25, 1
+	l.addi	r27, r27, 1
+	.endr
+	BENCH_LOOP_TAIL(1b)
+	OR1K_DELAYED_NOP(OR1K_INST(l.jr	r9))
+KERNEL
+  size=$((size * 2))
+done
+
+cat <<TABLE
+
+	.section .rodata
+	.global	icache_kernels
+	.balign	4
+icache_kernels:
+TABLE
+
+size=256
+while [ $size -le $MAX_SIZE ] ; do
+  echo "	.long	$size, icache_$size"
+  size=$((size * 2))
+done
+echo "	.long	0, 0"
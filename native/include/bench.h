@@ -0,0 +1,151 @@
+/*
+	Benchmark support
+
+	Shared definitions for the bench/ microbenchmarks. Every benchmark
+	reports its results with l.nop 0x2 as a tag word followed by the
+	values belonging to that tag, and finishes with the usual
+	0x8000000d / exit(0) sequence so runtests.sh treats it as a pass.
+
+	Tags have the form 0xbeNNMMMM where NN identifies the benchmark and
+	MMMM the measurement within it.
+
+	On cores with performance counters the first result is preceded by
+	BENCH_TAG(BENCH_ID_PCU, 0), the number of counters and their PCMR
+	events, and every result of a timed region carries that many
+	counts after its values (see bench_pcu_setup() in lib/bench.S).
+*/
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#define BENCH_TAG(bench, n)	(0xbe000000 | ((bench) << 16) | (n))
+
+/* Benchmark identifiers, used as NN in the tags */
+#define BENCH_ID_CPI		0x01
+#define BENCH_ID_BRANCH		0x02
+#define BENCH_ID_BPRED		0x03
+#define BENCH_ID_LSU		0x04
+#define BENCH_ID_MULDIV		0x05
+#define BENCH_ID_DCACHE		0x06
+#define BENCH_ID_ICACHE		0x07
+#define BENCH_ID_STREAM		0x08
+#define BENCH_ID_MEMOPS		0x09
+#define BENCH_ID_TLB		0x0a
+#define BENCH_ID_IRQ		0x0b
+#define BENCH_ID_TICKSTORM	0x0c
+#define BENCH_ID_EXCEPT		0x0d
+#define BENCH_ID_SCHED		0x0e
+#define BENCH_ID_STOREBUF	0x0f
+#define BENCH_ID_CACHEMAINT	0x10
+#define BENCH_ID_PREFETCH	0x11
+#define BENCH_ID_DCPOLICY	0x12
+#define BENCH_ID_CIPAGE		0x13
+#define BENCH_ID_PCU		0x14
+#define BENCH_ID_PRINTF		0x15
+#define BENCH_ID_BOOT		0x16
+
+/* Default loop shape: BENCH_ITERS iterations of BENCH_UNROLL operations */
+#define BENCH_ITERS		256
+#define BENCH_UNROLL		64
+/* log2(BENCH_ITERS * BENCH_UNROLL) - 8, turns a cycle count for the
+   default loop shape into 8.8 fixed point cycles per operation */
+#define BENCH_CPI_SHIFT		6
+
+/* Tick timer free running without interrupts */
+#define BENCH_TTMR_FREERUN						\
+	((OR1K_SPR_TICK_TTMR_MODE_CONTINUE << OR1K_SPR_TICK_TTMR_MODE_LSB) | \
+	 OR1K_SPR_TICK_TTMR_TP_MASK)
+
+#ifdef __ASSEMBLER__
+
+/*
+	Register usage
+
+	bench_time keeps its state in r13-r16 and bench_cpi in r17-r20.
+	Kernels are entered with the iteration count in r3 and the return
+	address in r9 and may use r3-r8, r11, r12 and r21-r31.
+*/
+
+/* Load a 32-bit constant */
+#define BENCH_LI(rd, val)			\
+	l.movhi	rd, hi(val)			;\
+	l.ori	rd, rd, lo(val)
+
+/* Start the cycle source with timer_init(), see timer.h for the
+   registers clobbered, r9 included */
+#define BENCH_TIMER_START				\
+	OR1K_DELAYED_NOP(OR1K_INST(l.jal	timer_init))
+
+/* Count down r3 and loop back to lbl while it is non-zero */
+#define BENCH_LOOP_TAIL(lbl)				\
+	l.addi	r3, r3, -1				;\
+	l.sfne	r3, r0					;\
+	OR1K_DELAYED_NOP(OR1K_INST(l.bf	lbl))
+
+/* Report one register */
+#define BENCH_REPORT(rs)				\
+	l.or	r3, rs, r0				;\
+	l.nop	0x2
+
+/* Time kernel against the empty kernel over iters iterations and report
+   tag, cycles and cycles per operation, shift as for BENCH_CPI_SHIFT */
+#define BENCH_RUN_CPI_BASE(tag, kernel, empty, iters, shift) \
+	BENCH_LI(r3, tag)				;\
+	BENCH_LI(r4, kernel)				;\
+	BENCH_LI(r5, empty)				;\
+	l.ori	r6, r0, iters				;\
+	OR1K_DELAYED(					\
+	OR1K_INST(l.ori	r7, r0, shift),			\
+	OR1K_INST(l.jal	bench_cpi)			\
+	)
+
+/* BENCH_RUN_CPI_BASE against bench_empty */
+#define BENCH_RUN_CPI_N(tag, kernel, iters, shift)	\
+	BENCH_RUN_CPI_BASE(tag, kernel, bench_empty, iters, shift)
+
+/* BENCH_RUN_CPI_N for the default loop shape */
+#define BENCH_RUN_CPI(tag, kernel)			\
+	BENCH_RUN_CPI_N(tag, kernel, BENCH_ITERS, BENCH_CPI_SHIFT)
+
+/* Report the pass value and leave the simulation */
+#define BENCH_EXIT					\
+	BENCH_LI(r3, 0x8000000d)			;\
+	l.nop	0x2					;\
+	l.ori	r3, r0, 0				;\
+	l.nop	0x1
+
+#else /* !__ASSEMBLER__ */
+
+#include <or1k-sprs.h>
+#include "support.h"
+#include "pcu.h"
+#include "timer.h"
+
+/* Start the cycle source, see timer.h */
+static inline void bench_timer_start(void)
+{
+  timer_init();
+}
+
+/* Differences of two reads are cycles, modulo 2^32 */
+static inline unsigned long bench_timer_read(void)
+{
+  return cycles_now();
+}
+
+/* Program the PCU for the stall breakdown, see lib/bench.S */
+void bench_pcu_setup(void);
+
+/* Report the counts of the last pcu_start() / pcu_stop() region, one
+   per counter programmed by bench_pcu_setup(), nothing without a PCU */
+static inline void bench_pcu_report(void)
+{
+  unsigned long counts[PCU_MAX_COUNTERS];
+  int i, n = pcu_read(counts);
+
+  for (i = 0; i < n; i++)
+    report(counts[i]);
+}
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _BENCH_H_ */
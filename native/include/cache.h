@@ -0,0 +1,53 @@
+/*
+	Cache maintenance over address ranges
+
+	Line by line block operations in libsupport, for DMA buffers and
+	code written at run time. Each walks every cache line touching
+	[start, start + size), the line size is read from DCCFGR or ICCFGR
+	on every call, and a zero size does nothing.
+
+	dcache_flush_range()	 DCBFR, write back dirty lines and
+				 invalidate
+	dcache_writeback_range() DCBWR, write back dirty lines and keep
+				 them valid
+	dcache_inval_range()	 DCBIR, invalidate, dirty data is lost
+	icache_inval_range()	 ICBIR, invalidate
+
+	On a core without the cache the block registers are not
+	implemented and the writes are ignored.
+
+	cache_line() and cache_size() give the line and total size in
+	bytes from a DCCFGR or ICCFGR value, and OR32_L_JR_R9 and
+	OR32_L_NOP are the machine code of a return stub for code
+	written at run time.
+*/
+#ifndef _CACHE_H_
+#define _CACHE_H_
+
+#include <stddef.h>
+#include "spr-defs.h"
+
+/* Machine code for l.jr r9 and l.nop */
+#define OR32_L_JR_R9	0x44004800
+#define OR32_L_NOP	0x15000000
+
+void dcache_flush_range(void *start, size_t size);
+void dcache_writeback_range(void *start, size_t size);
+void dcache_inval_range(void *start, size_t size);
+void icache_inval_range(void *start, size_t size);
+
+/* ICCFGR has the same NCW, NCS and CBS fields as DCCFGR */
+static inline unsigned long
+cache_line(unsigned long cfgr)
+{
+  return 16 << ((cfgr & SPR_DCCFGR_CBS) >> SPR_DCCFGR_CBS_OFF);
+}
+
+static inline unsigned long
+cache_size(unsigned long cfgr)
+{
+  return cache_line(cfgr) << ((cfgr & SPR_DCCFGR_NCS) >> SPR_DCCFGR_NCS_OFF)
+    << ((cfgr & SPR_DCCFGR_NCW) >> SPR_DCCFGR_NCW_OFF);
+}
+
+#endif /* _CACHE_H_ */
@@ -0,0 +1,29 @@
+/*
+	Word-at-a-time memory routines
+
+	Assembly versions of memcpy, memmove, memset and memcmp in
+	libsupport. They align the destination, move 32-byte blocks (a
+	whole cache line or two, DCCFGR[CBS] allows 16 or 32 bytes), then
+	words and bytes, with delay slots filled on delay slot builds.
+
+	Tests pick them up explicitly, or define FASTMEM_REPLACE before
+	including this file to route the standard names to them.
+*/
+#ifndef _FASTMEM_H_
+#define _FASTMEM_H_
+
+#include <stddef.h>
+
+void *fast_memcpy(void *dst, const void *src, size_t n);
+void *fast_memmove(void *dst, const void *src, size_t n);
+void *fast_memset(void *dst, int c, size_t n);
+int fast_memcmp(const void *a, const void *b, size_t n);
+
+#ifdef FASTMEM_REPLACE
+#define memcpy	fast_memcpy
+#define memmove	fast_memmove
+#define memset	fast_memset
+#define memcmp	fast_memcmp
+#endif
+
+#endif /* _FASTMEM_H_ */
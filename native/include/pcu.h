@@ -0,0 +1,49 @@
+/*
+	Performance counter unit driver
+
+	pcu_init() finds the counters, through UPR[PCUP], PCCFGR[NPC] and
+	PCMR[CP] of each, and stops them. pcu_program() gives counters 0
+	to n - 1 one PCMR event mask each, pcu_start() clears them and
+	counts in supervisor and user mode, pcu_stop() freezes them and
+	pcu_read() copies them out.
+
+	The routines are assembly leaf functions which only clobber r3-r8
+	and r11, so assembly tests without a stack can call them as well.
+	Without a PCU pcu_init() returns 0 and the others do nothing.
+*/
+#ifndef _PCU_H_
+#define _PCU_H_
+
+#include "spr-defs.h"
+
+#define PCU_MAX_COUNTERS	8
+
+/* Every PCMR event */
+#define PCU_EVENTS		(SPR_PCMR_LA | SPR_PCMR_SA | SPR_PCMR_IF | \
+				 SPR_PCMR_DCM | SPR_PCMR_ICM | \
+				 SPR_PCMR_IFS | SPR_PCMR_LSUS | \
+				 SPR_PCMR_BS | SPR_PCMR_DTLBM | \
+				 SPR_PCMR_ITLBM | SPR_PCMR_DDS | \
+				 SPR_PCMR_WPE)
+
+/* PCMR bits turning a counter on */
+#define PCU_COUNT		(SPR_PCMR_CISM | SPR_PCMR_CIUM)
+
+#ifndef __ASSEMBLER__
+
+/* Returns the number of counters, 0 without a PCU */
+int pcu_init(void);
+
+/* Program events[i] into counter i, for as many of the n events as
+   there are counters. Returns the number of counters programmed. */
+int pcu_program(const unsigned long *events, int n);
+
+void pcu_start(void);
+void pcu_stop(void);
+
+/* Copy the programmed counters to counts, returns how many */
+int pcu_read(unsigned long *counts);
+
+#endif
+
+#endif /* _PCU_H_ */
@@ -0,0 +1,85 @@
+/*
+	Two level page tables
+
+	A page table in the style of Linux/or1k and libsupport DTLB and
+	ITLB miss handlers that walk it. The page directory has one entry
+	per 16 MiB, each pointing to a table of 2048 PTEs for 8 KiB pages,
+	or 0 when nothing in that range is mapped.
+
+	A PTE holds the physical page number and the DTLBTR bits, plus
+	PGTABLE_EXEC and PGTABLE_PRESENT. The DTLB handler copies the PTE
+	into DTLBTR; the ITLB handler only maps pages with PGTABLE_EXEC,
+	keeps the cache bits and gives both SXE and UXE. An address without
+	a usable PTE gets a TLB entry without any permission so the access
+	is retried into a page fault, which a test can catch with
+	or1k_exception_handler_add().
+
+	Entries are written the way tlbrefill.h describes and the handlers
+	share its scratch words and refill counts. Install them with
+	vector_patch() at 0x900 and 0xa00.
+
+	The tables are walked by physical address with the MMUs off, and by
+	virtual address from C, so the pool must be mapped one to one
+	while map_range() runs with the DMMU on.
+*/
+#ifndef _PGTABLE_H_
+#define _PGTABLE_H_
+
+#include "spr-defs.h"
+
+#define PGTABLE_PAGE_SHIFT	13
+#define PGTABLE_PAGE_SIZE	(1 << PGTABLE_PAGE_SHIFT)
+#define PGTABLE_PGD_SHIFT	24
+#define PGTABLE_PTRS_PER_PGD	256
+#define PGTABLE_PTRS_PER_PTE	2048
+
+/* Pool space taken by the directory and by each PTE table */
+#define PGTABLE_PGD_SIZE	(PGTABLE_PTRS_PER_PGD * 4)
+#define PGTABLE_PTE_SIZE	(PGTABLE_PTRS_PER_PTE * 4)
+
+/* PTE bits */
+#define PGTABLE_CC		SPR_DTLBTR_CC
+#define PGTABLE_CI		SPR_DTLBTR_CI
+#define PGTABLE_WBC		SPR_DTLBTR_WBC
+#define PGTABLE_WOM		SPR_DTLBTR_WOM
+#define PGTABLE_A		SPR_DTLBTR_A
+#define PGTABLE_D		SPR_DTLBTR_D
+#define PGTABLE_URE		SPR_DTLBTR_URE
+#define PGTABLE_UWE		SPR_DTLBTR_UWE
+#define PGTABLE_SRE		SPR_DTLBTR_SRE
+#define PGTABLE_SWE		SPR_DTLBTR_SWE
+#define PGTABLE_EXEC		0x00000400
+#define PGTABLE_PRESENT		0x00000800
+
+/* Common protections */
+#define PGTABLE_RW		(PGTABLE_URE | PGTABLE_UWE | \
+				 PGTABLE_SRE | PGTABLE_SWE)
+#define PGTABLE_RWX		(PGTABLE_RW | PGTABLE_EXEC)
+
+#ifndef __ASSEMBLER__
+
+/* Start empty page tables in pool, which must be word aligned and at
+   least PGTABLE_PGD_SIZE bytes, PTE tables are taken from the rest of
+   it. Also calls tlb_refill_init(), so run it with the MMUs off.
+   Returns 0, or -1 when the pool is too small. */
+int pgtable_init(void *pool, unsigned long size);
+
+/* Map size bytes at va to pa with the PTE bits in prot, any TLB entry
+   for the pages is dropped. Returns 0, or -1 when the pool runs out
+   of PTE tables. */
+int map_range(unsigned long va, unsigned long pa, unsigned long size,
+	      unsigned long prot);
+
+/* Remove the mappings of size bytes at va */
+void unmap_range(unsigned long va, unsigned long size);
+
+/* The PTE for va, 0 when unmapped */
+unsigned long pgtable_lookup(unsigned long va);
+
+/* Exception handlers */
+void pgtable_dtlb_miss(void);
+void pgtable_itlb_miss(void);
+
+#endif
+
+#endif /* _PGTABLE_H_ */
@@ -0,0 +1,58 @@
+/*
+	Result buffer
+
+	results_put() keeps 32-bit result words, tags and values alike, in
+	a ring in RAM instead of reporting each one as it is produced, and
+	results_flush() gets them out at the end, in one of three modes:
+
+	RESULTS_BURST	 reports RESULTS_BURST_TAG, the number of words
+			 and the number lost to the ring wrapping, then
+			 the words oldest first, in one tight loop
+	RESULTS_DUMP	 reports RESULTS_DUMP_TAG, the ring address, its
+			 size, the index of the oldest word, the number of
+			 words and the number lost, leaving the runner to
+			 dump the ring from memory and decode it with
+			 results-decode.sh
+	RESULTS_STREAM	 results_put() reports every word straight away,
+			 as report() does, and results_flush() has nothing
+			 left to do
+
+	RESULTS_BURST only moves the reports out of the code under test to
+	the end of the run. The simulator still formats and logs one line
+	per word, so it takes as much wall time as report(). Only
+	RESULTS_DUMP logs less, and it needs a runner that dumps memory,
+	which runtests.sh does not do.
+
+	Without results_init() the ring is RESULTS_WORDS words in .bss in
+	RESULTS_BURST mode. exit() in libsupport flushes the ring, so a
+	failing test loses nothing; a main() that returns should call
+	results_flush() itself.
+*/
+#ifndef _RESULTS_H_
+#define _RESULTS_H_
+
+#define RESULTS_BURST		0
+#define RESULTS_DUMP		1
+#define RESULTS_STREAM		2
+
+/* Default ring size in words */
+#define RESULTS_WORDS		4096
+
+/* First word of a flush, by mode */
+#define RESULTS_BURST_TAG	0x7e5b0000
+#define RESULTS_DUMP_TAG	0x7e5d0000
+
+#ifndef __ASSEMBLER__
+
+/* Use words words at buf as the ring, the default one for a NULL buf,
+   and flush in mode. Drops anything not yet flushed. */
+void results_init(unsigned long *buf, unsigned long words, int mode);
+
+void results_put(unsigned long value);
+
+/* Flush and empty the ring, nothing when it is already empty */
+void results_flush(void);
+
+#endif
+
+#endif /* _RESULTS_H_ */
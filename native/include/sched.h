@@ -0,0 +1,56 @@
+/*
+	Preemptive round robin scheduler
+
+	A minimal scheduler in libsupport driven by the tick timer. Tasks
+	sit in a ring; every tick the handler in switch.S, jumped to
+	straight from the patched 0x500 vector (see vector.h), saves all
+	GPRs, EPCR and ESR of the running task into its struct sched_task,
+	acknowledges the tick and resumes the next task in the ring.
+
+	sched_init() turns the caller into the first task of an empty ring,
+	sched_add() adds more, sched_start() starts the timer in restart
+	mode with the given period in ticks and sched_stop() stops it,
+	leaving the caller running and the other tasks suspended. A task
+	function that returns spins until the scheduler is stopped.
+
+	The handler keeps its state in scratch words relative to r0, after
+	the ones in tlbrefill.h.
+*/
+#ifndef _SCHED_H_
+#define _SCHED_H_
+
+/* Scratch words, addresses relative to r0 */
+#define SCHED_SAVE_R3		0x50
+#define SCHED_CURRENT		0x54	/* Running struct sched_task */
+#define SCHED_TTMR		0x58	/* TTMR value rewritten every tick */
+#define SCHED_SWITCHES		0x5c	/* Ticks taken since sched_start() */
+
+/* struct sched_task layout for switch.S */
+#define SCHED_TASK_EPCR		128
+#define SCHED_TASK_ESR		132
+#define SCHED_TASK_NEXT		136
+
+#ifndef __ASSEMBLER__
+
+#define SCHED_VAR(off)		(*(volatile unsigned long *) (off))
+
+struct sched_task
+{
+  unsigned long gpr[32];	/* gpr[0] unused */
+  unsigned long epcr;
+  unsigned long esr;
+  struct sched_task *next;
+};
+
+void sched_init(struct sched_task *self);
+void sched_add(struct sched_task *task, void (*fn) (void *), void *arg,
+	       void *stack, unsigned long stack_size);
+void sched_start(unsigned long period);
+void sched_stop(void);
+
+/* Tick handler */
+void sched_tick_handler(void);
+
+#endif
+
+#endif /* _SCHED_H_ */
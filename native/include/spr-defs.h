@@ -597,6 +597,14 @@
 #define SPR_DRR_FPE     0x00001000  /* Floating Point Exception */
 #define SPR_DRR_TE	0x00002000  /* Trap exception */
 
+/*
+ * Bit definitions for Performance Counters Configuration Register
+ *
+ */
+#define SPR_PCCFGR_NPC		0x00000007  /* Number of counters - 1 */
+
+#define SPR_PCCFGR_NPC_OFF	0
+
 /*
  * Bit definitions for Performance counters mode registers
  *
@@ -0,0 +1,67 @@
+/*
+	Cycle timing
+
+	One timing path for C and assembly benchmarks. timer_init() picks
+	the cycle source and calibrates it:
+	  - under or1ksim, found with l.nop NOP_OR1KSIM, l.nop
+	    NOP_GET_TICKS, the simulator's own 64-bit cycle count, which
+	    leaves the tick timer free for the test
+	  - with UPR[TTP], TTCR. A stopped tick timer is started free
+	    running, a running one is left as it is and assumed to run
+	    in continuous mode
+	  - otherwise nothing, and every count reads 0
+	Before timer_init() cycles_now() reads TTCR as it is.
+
+	cycles_elapsed() is modulo 2^32, so one TTCR wrap between the two
+	reads is harmless. cycles_now64() extends TTCR by counting the
+	wraps it sees, which holds as long as it is called at least once
+	per 2^32 cycles and nothing else writes TTCR. timer_overhead, the
+	cost of an empty cycles_now() / cycles_elapsed() region, is
+	taken off every cycles_elapsed() result.
+
+	The routines are assembly leaf functions, cycles_now() and
+	cycles_now64() clobber r3, r4, r11 and r12, cycles_elapsed() r3-r7,
+	r11 and r12 and timer_init() also r8, r21, r23 and r25, so
+	assembly tests without a stack can call them as well, and the
+	bench.h helpers between kernels.
+*/
+#ifndef _TIMER_H_
+#define _TIMER_H_
+
+/* Cycle sources, returned by timer_init() */
+#define TIMER_NONE		0
+#define TIMER_TTCR		1
+#define TIMER_SIM		2
+
+/* Empty regions timed by timer_init(), the least is the overhead */
+#define TIMER_CALIBRATE		8
+
+#ifndef __ASSEMBLER__
+
+struct timer_stats
+{
+  unsigned long min;
+  unsigned long median;
+  unsigned long max;
+};
+
+/* Returns the cycle source */
+unsigned long timer_init(void);
+
+unsigned long cycles_now(void);
+unsigned long long cycles_now64(void);
+
+/* Cycles since start, a cycles_now() value, less timer_overhead */
+unsigned long cycles_elapsed(unsigned long start);
+
+extern unsigned long timer_overhead;
+
+/* Call fn(arg) warmup times untimed, then reps times timed. Leaves the
+   cycles of each timed call sorted in samples, which holds reps
+   values, and their min, median and max in stats. Returns reps. */
+int timer_bench(void (*fn)(void *), void *arg, int warmup, int reps,
+		unsigned long *samples, struct timer_stats *stats);
+
+#endif
+
+#endif /* _TIMER_H_ */
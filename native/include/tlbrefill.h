@@ -0,0 +1,72 @@
+/*
+	Fast TLB refill handlers
+
+	Assembly DTLB and ITLB miss handlers in libsupport that map the
+	missing page one to one. They are meant to be jumped to straight
+	from the exception vector (see vector.h) rather than through the
+	newlib exception dispatcher, and only use r3-r6, which they save in
+	the scratch words below.
+
+	The way written is picked round robin, wrapping at the way count
+	from xMMUCFGR[NTW] so all ways of a 3 way TLB are used, the set
+	from the page number. Pages are 8 KiB, mapped cacheable with
+	all supervisor and user permissions.
+
+	The scratch words live in the otherwise unused space below the
+	reset vector so the handlers can reach them relative to r0 with
+	no free register.
+*/
+#ifndef _TLBREFILL_H_
+#define _TLBREFILL_H_
+
+#include "spr-defs.h"
+
+#define TLB_REFILL_PAGE_SHIFT	13
+#define TLB_REFILL_PAGE_SIZE	(1 << TLB_REFILL_PAGE_SHIFT)
+
+#define TLB_REFILL_DTLB_PR	(SPR_DTLBTR_URE | SPR_DTLBTR_UWE | \
+				 SPR_DTLBTR_SRE | SPR_DTLBTR_SWE)
+#define TLB_REFILL_ITLB_PR	(SPR_ITLBTR_SXE | SPR_ITLBTR_UXE)
+
+/* Scratch words, addresses relative to r0 */
+#define TLB_REFILL_DNEXT	0x08	/* DTLB way written next */
+#define TLB_REFILL_INEXT	0x0c	/* ITLB way written next */
+#define TLB_REFILL_SAVE_R3	0x10
+#define TLB_REFILL_SAVE_R4	0x14
+#define TLB_REFILL_SAVE_R5	0x18
+#define TLB_REFILL_SAVE_R6	0x1c
+#define TLB_REFILL_DCOUNT	0x20	/* DTLB refills */
+#define TLB_REFILL_ICOUNT	0x24	/* ITLB refills */
+#define TLB_REFILL_DSETS	0x28	/* DTLB sets - 1 */
+#define TLB_REFILL_DWAYS	0x2c	/* DMMUCFGR[NTW], ways - 1 */
+#define TLB_REFILL_ISETS	0x30	/* ITLB sets - 1 */
+#define TLB_REFILL_IWAYS	0x34	/* IMMUCFGR[NTW], ways - 1 */
+#define TLB_REFILL_PGD		0x38	/* Page directory, see pgtable.h */
+
+#ifndef __ASSEMBLER__
+
+#define TLB_REFILL_VAR(off)	(*(volatile unsigned long *) (off))
+
+/* The way to write next, advancing the round robin in the next scratch
+   word and wrapping after the last way, as the assembly handlers do */
+static inline unsigned long tlb_refill_next_way(unsigned long next,
+						unsigned long ways)
+{
+  unsigned long way = TLB_REFILL_VAR(next);
+
+  TLB_REFILL_VAR(next) = way < TLB_REFILL_VAR(ways) ? way + 1 : 0;
+
+  return way;
+}
+
+/* Record the TLB geometry, clear the refill counts and invalidate every
+   TLB entry. Call with the MMUs disabled. */
+void tlb_refill_init(void);
+
+/* Exception handlers, install with vector_patch() at 0x900 and 0xa00 */
+void tlb_refill_dtlb_miss(void);
+void tlb_refill_itlb_miss(void);
+
+#endif
+
+#endif /* _TLBREFILL_H_ */
@@ -0,0 +1,42 @@
+/*
+	Buffered test output
+
+	A small formatted print for tests, in place of newlib stdio. Output
+	collects in a TPRINT_BUF_SIZE byte buffer in .bss, nothing is
+	allocated, and drains on every newline, when the buffer fills and
+	on tprint_flush() or exit(), to one of two sinks:
+
+	TPRINT_NOP	 l.nop NOP_PUTC a character at a time, which the
+			 simulators and the testbench print, the default
+	TPRINT_UART	 the 16550 at uart_base, polling the transmitter,
+			 after tprint_init() programs 8N1 with divisor
+
+	tprintf() knows the flags '-' and '0', a width, a precision, an
+	ignored 'l' and the conversions d, i, u, x, X, p, c, s and %.
+*/
+#ifndef _TPRINTF_H_
+#define _TPRINTF_H_
+
+#define TPRINT_NOP		0
+#define TPRINT_UART		1
+
+#define TPRINT_BUF_SIZE		256
+
+/* The UART0 of board.h */
+#define tprint_init_uart0()						\
+  tprint_init(TPRINT_UART, UART0_BASE, IN_CLK / (16 * UART0_BAUD_RATE))
+
+/* Drain to sink, uart_base and divisor only matter for TPRINT_UART */
+void tprint_init(int sink, unsigned long uart_base, unsigned long divisor);
+
+int tputchar(int c);
+
+/* The string and a newline, as puts() */
+int tputs(const char *s);
+
+int tprintf(const char *fmt, ...)
+  __attribute__ ((format (printf, 1, 2)));
+
+void tprint_flush(void);
+
+#endif /* _TPRINTF_H_ */
@@ -0,0 +1,26 @@
+/*
+	Exception vector patching
+
+	Replaces the start of an exception vector with a direct jump to a
+	handler, bypassing the newlib dispatcher which saves the whole
+	register file and switches stacks. The handler runs in exception
+	context with the interrupted registers live and must return with
+	l.rfe itself.
+
+	The vector address is the physical one, e.g. 0x900 for the DTLB
+	miss exception, and must be within l.j range of the handler.
+*/
+#ifndef _VECTOR_H_
+#define _VECTOR_H_
+
+#define VECTOR_PATCH_WORDS	2
+
+/* Patch vector to jump to handler, the replaced words go to saved */
+void vector_patch(unsigned long vector, void (*handler)(void),
+		  unsigned long saved[VECTOR_PATCH_WORDS]);
+
+/* Put back the words saved by vector_patch() */
+void vector_restore(unsigned long vector,
+		    const unsigned long saved[VECTOR_PATCH_WORDS]);
+
+#endif /* _VECTOR_H_ */
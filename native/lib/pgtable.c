@@ -0,0 +1,127 @@
+#include <support.h>
+#include <spr-defs.h>
+#include <pgtable.h>
+#include <tlbrefill.h>
+
+static unsigned long *pgtable_pgd;
+static char *pgtable_next;
+static char *pgtable_limit;
+
+int pgtable_init(void *pool, unsigned long size)
+{
+  int i;
+
+  if (size < PGTABLE_PGD_SIZE)
+    return -1;
+
+  pgtable_pgd = pool;
+  pgtable_next = (char *) pool + PGTABLE_PGD_SIZE;
+  pgtable_limit = (char *) pool + size;
+
+  for (i = 0; i < PGTABLE_PTRS_PER_PGD; i++)
+    pgtable_pgd[i] = 0;
+
+  tlb_refill_init();
+  TLB_REFILL_VAR(TLB_REFILL_PGD) = (unsigned long) pgtable_pgd;
+
+  return 0;
+}
+
+/* The PTE for va, allocating its table when alloc is set */
+static unsigned long *pgtable_pte(unsigned long va, int alloc)
+{
+  unsigned long *pgd = &pgtable_pgd[va >> PGTABLE_PGD_SHIFT];
+  unsigned long *table;
+  int i;
+
+  if (!*pgd)
+    {
+      if (!alloc || pgtable_limit - pgtable_next < PGTABLE_PTE_SIZE)
+	return 0;
+
+      table = (unsigned long *) pgtable_next;
+      pgtable_next += PGTABLE_PTE_SIZE;
+      for (i = 0; i < PGTABLE_PTRS_PER_PTE; i++)
+	table[i] = 0;
+      *pgd = (unsigned long) table;
+    }
+
+  table = (unsigned long *) *pgd;
+  return &table[(va >> PGTABLE_PAGE_SHIFT) & (PGTABLE_PTRS_PER_PTE - 1)];
+}
+
+/* Drop any DTLB or ITLB entry translating the page at va */
+static void pgtable_flush_page(unsigned long va)
+{
+  unsigned long upr = mfspr(SPR_UPR);
+  unsigned long way, set;
+
+  if (upr & SPR_UPR_DMP)
+    {
+      set = (va >> PGTABLE_PAGE_SHIFT) & TLB_REFILL_VAR(TLB_REFILL_DSETS);
+      for (way = 0; way <= TLB_REFILL_VAR(TLB_REFILL_DWAYS); way++)
+	if ((mfspr(SPR_DTLBMR_BASE(way) + set) & SPR_DTLBMR_VPN) ==
+	    (va & SPR_DTLBMR_VPN))
+	  mtspr(SPR_DTLBMR_BASE(way) + set, 0);
+    }
+
+  if (upr & SPR_UPR_IMP)
+    {
+      set = (va >> PGTABLE_PAGE_SHIFT) & TLB_REFILL_VAR(TLB_REFILL_ISETS);
+      for (way = 0; way <= TLB_REFILL_VAR(TLB_REFILL_IWAYS); way++)
+	if ((mfspr(SPR_ITLBMR_BASE(way) + set) & SPR_ITLBMR_VPN) ==
+	    (va & SPR_ITLBMR_VPN))
+	  mtspr(SPR_ITLBMR_BASE(way) + set, 0);
+    }
+}
+
+static unsigned long pgtable_pages(unsigned long va, unsigned long size)
+{
+  return ((va & (PGTABLE_PAGE_SIZE - 1)) + size + PGTABLE_PAGE_SIZE - 1)
+    >> PGTABLE_PAGE_SHIFT;
+}
+
+int map_range(unsigned long va, unsigned long pa, unsigned long size,
+	      unsigned long prot)
+{
+  unsigned long n = pgtable_pages(va, size);
+  unsigned long *pte;
+
+  va &= ~(PGTABLE_PAGE_SIZE - 1);
+  pa &= ~(PGTABLE_PAGE_SIZE - 1);
+
+  for (; n; n--, va += PGTABLE_PAGE_SIZE, pa += PGTABLE_PAGE_SIZE)
+    {
+      pte = pgtable_pte(va, 1);
+      if (!pte)
+	return -1;
+
+      *pte = pa | (prot & (PGTABLE_PAGE_SIZE - 1)) | PGTABLE_PRESENT;
+      pgtable_flush_page(va);
+    }
+
+  return 0;
+}
+
+void unmap_range(unsigned long va, unsigned long size)
+{
+  unsigned long n = pgtable_pages(va, size);
+  unsigned long *pte;
+
+  va &= ~(PGTABLE_PAGE_SIZE - 1);
+
+  for (; n; n--, va += PGTABLE_PAGE_SIZE)
+    {
+      pte = pgtable_pte(va, 0);
+      if (pte)
+	*pte = 0;
+      pgtable_flush_page(va);
+    }
+}
+
+unsigned long pgtable_lookup(unsigned long va)
+{
+  unsigned long *pte = pgtable_pte(va, 0);
+
+  return pte ? *pte : 0;
+}
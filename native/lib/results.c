@@ -0,0 +1,86 @@
+#include <stddef.h>
+#include <support.h>
+#include <results.h>
+
+static unsigned long results_default[RESULTS_WORDS];
+
+static unsigned long *results_buf = results_default;
+static unsigned long results_size = RESULTS_WORDS;
+static int results_mode = RESULTS_BURST;
+
+/* Next word written, words held and words overwritten before a flush */
+static unsigned long results_head;
+static unsigned long results_count;
+static unsigned long results_lost;
+
+void results_init(unsigned long *buf, unsigned long words, int mode)
+{
+  if (buf == NULL)
+    {
+      buf = results_default;
+      words = RESULTS_WORDS;
+    }
+
+  results_buf = buf;
+  results_size = words;
+  results_mode = mode;
+  results_head = 0;
+  results_count = 0;
+  results_lost = 0;
+}
+
+void results_put(unsigned long value)
+{
+  if (results_mode == RESULTS_STREAM)
+    {
+      report(value);
+      return;
+    }
+
+  results_buf[results_head] = value;
+  if (++results_head == results_size)
+    results_head = 0;
+
+  if (results_count < results_size)
+    results_count++;
+  else
+    results_lost++;
+}
+
+void results_flush(void)
+{
+  unsigned long i, oldest;
+
+  if (results_mode == RESULTS_STREAM ||
+      (results_count == 0 && results_lost == 0))
+    return;
+
+  oldest = results_head >= results_count ? results_head - results_count :
+    results_head + results_size - results_count;
+
+  if (results_mode == RESULTS_DUMP)
+    {
+      report(RESULTS_DUMP_TAG);
+      report((unsigned long) results_buf);
+      report(results_size);
+      report(oldest);
+      report(results_count);
+      report(results_lost);
+    }
+  else
+    {
+      report(RESULTS_BURST_TAG);
+      report(results_count);
+      report(results_lost);
+      for (i = 0; i < results_count; i++)
+	{
+	  report(results_buf[oldest]);
+	  if (++oldest == results_size)
+	    oldest = 0;
+	}
+    }
+
+  /* The head stays, so a dumped ring is only overwritten once full */
+  results_count = 0;
+  results_lost = 0;
+}
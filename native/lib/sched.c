@@ -0,0 +1,59 @@
+#include <support.h>
+#include <spr-defs.h>
+#include <sched.h>
+#include <vector.h>
+
+#define SCHED_VECTOR	0x500
+
+static unsigned long sched_saved[VECTOR_PATCH_WORDS];
+
+/* Where task functions return to */
+static void sched_task_exit(void)
+{
+  while (1);
+}
+
+void sched_init(struct sched_task *self)
+{
+  self->next = self;
+  SCHED_VAR(SCHED_CURRENT) = (unsigned long) self;
+  SCHED_VAR(SCHED_SWITCHES) = 0;
+}
+
+void sched_add(struct sched_task *task, void (*fn) (void *), void *arg,
+	       void *stack, unsigned long stack_size)
+{
+  struct sched_task *current = (struct sched_task *) SCHED_VAR(SCHED_CURRENT);
+  int i;
+
+  for (i = 0; i < 32; i++)
+    task->gpr[i] = 0;
+
+  task->gpr[1] = ((unsigned long) stack + stack_size) & ~7;
+  task->gpr[3] = (unsigned long) arg;
+  task->gpr[9] = (unsigned long) sched_task_exit;
+  task->epcr = (unsigned long) fn;
+  task->esr = mfspr(SPR_SR) | SPR_SR_TEE;
+
+  task->next = current->next;
+  current->next = task;
+}
+
+void sched_start(unsigned long period)
+{
+  SCHED_VAR(SCHED_TTMR) = SPR_TTMR_RT | SPR_TTMR_IE | (period & SPR_TTMR_TP);
+
+  vector_patch(SCHED_VECTOR, sched_tick_handler, sched_saved);
+
+  mtspr(SPR_TTCR, 0);
+  mtspr(SPR_TTMR, SCHED_VAR(SCHED_TTMR));
+  mtspr(SPR_SR, mfspr(SPR_SR) | SPR_SR_TEE);
+}
+
+void sched_stop(void)
+{
+  mtspr(SPR_SR, mfspr(SPR_SR) & ~SPR_SR_TEE);
+  mtspr(SPR_TTMR, 0);
+
+  vector_restore(SCHED_VECTOR, sched_saved);
+}
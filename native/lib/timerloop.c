@@ -0,0 +1,36 @@
+#include <timer.h>
+
+int timer_bench(void (*fn)(void *), void *arg, int warmup, int reps,
+		unsigned long *samples, struct timer_stats *stats)
+{
+  unsigned long start, v;
+  int i, j;
+
+  for (i = 0; i < warmup; i++)
+    fn(arg);
+
+  for (i = 0; i < reps; i++)
+    {
+      start = cycles_now();
+      fn(arg);
+      samples[i] = cycles_elapsed(start);
+    }
+
+  /* Insertion sort, reps is small and nothing is allocated */
+  for (i = 1; i < reps; i++)
+    {
+      v = samples[i];
+      for (j = i; j > 0 && samples[j - 1] > v; j--)
+	samples[j] = samples[j - 1];
+      samples[j] = v;
+    }
+
+  if (reps > 0)
+    {
+      stats->min = samples[0];
+      stats->median = samples[reps / 2];
+      stats->max = samples[reps - 1];
+    }
+
+  return reps;
+}
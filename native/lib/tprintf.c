@@ -0,0 +1,227 @@
+#include <stdarg.h>
+#include <support.h>
+#include <tprintf.h>
+
+/* 16550 registers */
+#define UART_THR	0
+#define UART_DLL	0
+#define UART_IER	1
+#define UART_DLM	1
+#define UART_FCR	2
+#define UART_LCR	3
+#define UART_LSR	5
+
+#define UART_LCR_8N1	0x03
+#define UART_LCR_DLAB	0x80
+#define UART_FCR_RESET	0x07	/* Enable and clear both FIFOs */
+#define UART_LSR_THRE	0x20
+
+static char tprint_buf[TPRINT_BUF_SIZE];
+static unsigned int tprint_len;
+static int tprint_sink = TPRINT_NOP;
+static volatile unsigned char *tprint_uart;
+
+void tprint_init(int sink, unsigned long uart_base, unsigned long divisor)
+{
+  tprint_flush();
+
+  tprint_sink = sink;
+  if (sink != TPRINT_UART)
+    return;
+
+  tprint_uart = (volatile unsigned char *) uart_base;
+  tprint_uart[UART_IER] = 0;
+  tprint_uart[UART_LCR] = UART_LCR_DLAB;
+  tprint_uart[UART_DLL] = divisor & 0xff;
+  tprint_uart[UART_DLM] = (divisor >> 8) & 0xff;
+  tprint_uart[UART_LCR] = UART_LCR_8N1;
+  tprint_uart[UART_FCR] = UART_FCR_RESET;
+}
+
+void tprint_flush(void)
+{
+  unsigned int i;
+
+  for (i = 0; i < tprint_len; i++)
+    if (tprint_sink == TPRINT_UART)
+      {
+	while (!(tprint_uart[UART_LSR] & UART_LSR_THRE))
+	  ;
+	tprint_uart[UART_THR] = tprint_buf[i];
+      }
+    else
+      {
+	/* One statement, so nothing is scheduled between the two */
+	asm volatile ("l.or\tr3,%0,r0\n\tl.nop %1"
+		      : : "r" (tprint_buf[i]), "K" (NOP_PUTC) : "r3");
+      }
+
+  tprint_len = 0;
+}
+
+int tputchar(int c)
+{
+  tprint_buf[tprint_len++] = c;
+  if (c == '\n' || tprint_len == TPRINT_BUF_SIZE)
+    tprint_flush();
+
+  return (unsigned char) c;
+}
+
+int tputs(const char *s)
+{
+  while (*s)
+    tputchar(*s++);
+  tputchar('\n');
+
+  return 0;
+}
+
+/* Pad n characters out to width, returns the padding written */
+static int tprint_pad(int n, int width, char pad)
+{
+  int i;
+
+  for (i = n; i < width; i++)
+    tputchar(pad);
+
+  return i > n ? i - n : 0;
+}
+
+static int tprint_num(unsigned long v, unsigned int base, int upper, int neg,
+		      int width, int prec, char pad, int left)
+{
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  char tmp[11];
+  int n = 0, zeros, len, out = 0;
+
+  /* A precision of 0 prints nothing for 0, as printf() does */
+  while (v || (n == 0 && prec != 0))
+    {
+      tmp[n++] = digits[v % base];
+      v /= base;
+    }
+
+  zeros = prec > n ? prec - n : 0;
+  len = neg + zeros + n;
+
+  /* The 0 flag is ignored with a precision */
+  if (prec >= 0)
+    pad = ' ';
+
+  if (!left && pad == ' ')
+    out += tprint_pad(len, width, ' ');
+  if (neg)
+    tputchar('-');
+  if (!left && pad == '0')
+    out += tprint_pad(len, width, '0');
+  while (zeros--)
+    tputchar('0');
+  while (n)
+    tputchar(tmp[--n]);
+  if (left)
+    out += tprint_pad(len, width, ' ');
+
+  return out + len;
+}
+
+int tprintf(const char *fmt, ...)
+{
+  va_list ap;
+  const char *s;
+  unsigned long v;
+  int width, prec, left, i, n, out = 0;
+  char pad;
+
+  va_start(ap, fmt);
+
+  for (; *fmt; fmt++)
+    {
+      if (*fmt != '%')
+	{
+	  tputchar(*fmt);
+	  out++;
+	  continue;
+	}
+
+      left = 0;
+      pad = ' ';
+      for (fmt++; *fmt == '-' || *fmt == '0'; fmt++)
+	if (*fmt == '-')
+	  left = 1;
+	else
+	  pad = '0';
+      if (left)
+	pad = ' ';
+
+      for (width = 0; *fmt >= '0' && *fmt <= '9'; fmt++)
+	width = width * 10 + *fmt - '0';
+
+      prec = -1;
+      if (*fmt == '.')
+	for (prec = 0, fmt++; *fmt >= '0' && *fmt <= '9'; fmt++)
+	  prec = prec * 10 + *fmt - '0';
+
+      if (*fmt == 'l')
+	fmt++;
+
+      switch (*fmt)
+	{
+	case 'd':
+	case 'i':
+	  v = va_arg(ap, long);
+	  if ((long) v < 0)
+	    out += tprint_num(-v, 10, 0, 1, width, prec, pad, left);
+	  else
+	    out += tprint_num(v, 10, 0, 0, width, prec, pad, left);
+	  break;
+	case 'u':
+	  out += tprint_num(va_arg(ap, unsigned long), 10, 0, 0, width, prec,
+			    pad, left);
+	  break;
+	case 'x':
+	case 'X':
+	  out += tprint_num(va_arg(ap, unsigned long), 16, *fmt == 'X', 0,
+			    width, prec, pad, left);
+	  break;
+	case 'p':
+	  tputchar('0');
+	  tputchar('x');
+	  out += 2 + tprint_num((unsigned long) va_arg(ap, void *), 16, 0, 0,
+				width, prec, pad, left);
+	  break;
+	case 'c':
+	  if (!left)
+	    out += tprint_pad(1, width, ' ');
+	  tputchar(va_arg(ap, int));
+	  if (left)
+	    out += tprint_pad(1, width, ' ');
+	  out++;
+	  break;
+	case 's':
+	  s = va_arg(ap, const char *);
+	  for (n = 0; s[n] && (prec < 0 || n < prec); n++)
+	    ;
+	  if (!left)
+	    out += tprint_pad(n, width, ' ');
+	  for (i = 0; i < n; i++)
+	    tputchar(s[i]);
+	  if (left)
+	    out += tprint_pad(n, width, ' ');
+	  out += n;
+	  break;
+	case '%':
+	  tputchar('%');
+	  out++;
+	  break;
+	default:
+	  /* Unknown conversion or end of string, stop */
+	  va_end(ap);
+	  return out;
+	}
+    }
+
+  va_end(ap);
+
+  return out;
+}
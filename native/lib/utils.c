@@ -1,8 +1,16 @@
 #include <support.h>
 
-/* Loops/exits simulation */
+/* Weak so that only tests using results.h or tprintf.h pull them in */
+extern void results_flush (void) __attribute__ ((weak));
+extern void tprint_flush (void) __attribute__ ((weak));
+
+/* Loops/exits simulation, flushing the result ring and output first */
 void exit (int i)
 {
+  if (results_flush)
+    results_flush ();
+  if (tprint_flush)
+    tprint_flush ();
   asm("l.add r3,r0,%0": : "r" (i));
   asm("l.nop %0": :"K" (NOP_EXIT));
   while (1);
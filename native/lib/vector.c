@@ -0,0 +1,46 @@
+#include <support.h>
+#include <spr-defs.h>
+#include <vector.h>
+
+/* Machine code for l.j and l.nop */
+#define OR1K_L_J	0x00000000
+#define OR1K_L_NOP	0x15000000
+
+/* Write the vector words back to memory and drop any stale copy in the
+   instruction cache */
+static void vector_sync(unsigned long vector)
+{
+  int i;
+
+  for (i = 0; i < VECTOR_PATCH_WORDS; i++)
+    {
+      mtspr(SPR_DCBFR, vector + i * 4);
+      mtspr(SPR_ICBIR, vector + i * 4);
+    }
+}
+
+void vector_patch(unsigned long vector, void (*handler)(void),
+		  unsigned long saved[VECTOR_PATCH_WORDS])
+{
+  volatile unsigned long *v = (volatile unsigned long *) vector;
+  long offset = ((long) handler - (long) vector) >> 2;
+
+  saved[0] = v[0];
+  saved[1] = v[1];
+
+  v[0] = OR1K_L_J | (offset & 0x03ffffff);
+  v[1] = OR1K_L_NOP;
+
+  vector_sync(vector);
+}
+
+void vector_restore(unsigned long vector,
+		    const unsigned long saved[VECTOR_PATCH_WORDS])
+{
+  volatile unsigned long *v = (volatile unsigned long *) vector;
+
+  v[0] = saved[0];
+  v[1] = saved[1];
+
+  vector_sync(vector);
+}
@@ -0,0 +1,138 @@
+/*
+ * Cache block prefetch and lock test
+ *
+ * Writes DCBPR, DCBLR, ICBPR and ICBLR over a data buffer and over code
+ * written at run time, one line at a time, and checks that no data is
+ * lost or corrupted:
+ *  - prefetching clean and dirty data lines leaves their contents as
+ *    they were, and stores to them still reach memory on a flush
+ *  - stores to locked data lines reach memory on a flush, which also
+ *    unlocks them
+ *  - prefetched and locked instruction lines run, and rewriting the
+ *    code followed by an ICBIR, which unlocks them, runs the new code
+ *
+ * Reports DCCFGR and ICCFGR first. On a core without the CBPRI/CBLRI
+ * capability the writes are ignored and the checks still hold.
+ */
+
+#include "support.h"
+#include "spr-defs.h"
+#include "cache.h"
+
+#define BLOCK_LINES	16
+
+/* Machine code for l.ori r11,r0,0, cache.h has l.jr r9 and l.nop */
+#define OR32_L_ORI_R11	0xa9600000
+
+extern char end;
+
+static void
+fail(unsigned long where)
+{
+  report(where);
+  report(0xbaaaaaad);
+  exit(1);
+}
+
+/* Return stub at the start of every line returning value + line */
+static void
+code_write(char *code, unsigned long line, unsigned long value)
+{
+  unsigned long i;
+
+  for (i = 0; i < BLOCK_LINES; i++)
+    {
+      ((unsigned long *) (code + i * line))[0] = OR32_L_ORI_R11 | (value + i);
+      ((unsigned long *) (code + i * line))[1] = OR32_L_JR_R9;
+      ((unsigned long *) (code + i * line))[2] = OR32_L_NOP;
+    }
+  dcache_flush_range(code, BLOCK_LINES * line);
+  icache_inval_range(code, BLOCK_LINES * line);
+}
+
+static void
+code_check(char *code, unsigned long line, unsigned long value)
+{
+  unsigned long i;
+
+  for (i = 0; i < BLOCK_LINES; i++)
+    if (((unsigned long (*) (void)) (code + i * line)) () != value + i)
+      fail(0x1000 | value | i);
+}
+
+static void
+data_check(volatile unsigned long *data, unsigned long words,
+	   unsigned long value, unsigned long where)
+{
+  unsigned long i;
+
+  for (i = 0; i < words; i++)
+    if (data[i] != value + i)
+      fail(where | i);
+}
+
+int
+main(void)
+{
+  unsigned long dccfgr = mfspr(SPR_DCCFGR), iccfgr = mfspr(SPR_ICCFGR);
+  unsigned long dline, iline, words;
+  volatile unsigned long *data;
+  char *code;
+  unsigned long i;
+
+  dline = 16 << ((dccfgr & SPR_DCCFGR_CBS) >> SPR_DCCFGR_CBS_OFF);
+  iline = 16 << ((iccfgr & SPR_ICCFGR_CBS) >> SPR_ICCFGR_CBS_OFF);
+  words = BLOCK_LINES * dline / 4;
+
+  /* Past the program image, clear of the stack */
+  data = (volatile unsigned long *)
+    (((unsigned long) &end + 0xffff) & ~0xffff);
+  code = (char *) data + BLOCK_LINES * dline;
+
+  report(dccfgr);
+  report(iccfgr);
+
+  /* Prefetch clean lines */
+  for (i = 0; i < words; i++)
+    data[i] = 0x100 + i;
+  dcache_flush_range((void *) data, BLOCK_LINES * dline);
+  for (i = 0; i < BLOCK_LINES; i++)
+    mtspr(SPR_DCBPR, (unsigned long) data + i * dline);
+  data_check(data, words, 0x100, 0x2000);
+
+  /* Prefetch dirty lines, then flush */
+  for (i = 0; i < words; i++)
+    data[i] = 0x200 + i;
+  for (i = 0; i < BLOCK_LINES; i++)
+    mtspr(SPR_DCBPR, (unsigned long) data + i * dline);
+  data_check(data, words, 0x200, 0x3000);
+  dcache_flush_range((void *) data, BLOCK_LINES * dline);
+  data_check(data, words, 0x200, 0x4000);
+
+  /* Lock lines and store to them */
+  for (i = 0; i < BLOCK_LINES; i++)
+    mtspr(SPR_DCBLR, (unsigned long) data + i * dline);
+  for (i = 0; i < words; i++)
+    data[i] = 0x300 + i;
+  data_check(data, words, 0x300, 0x5000);
+  dcache_flush_range((void *) data, BLOCK_LINES * dline);
+  data_check(data, words, 0x300, 0x6000);
+  report(data[words - 1]);
+
+  /* Prefetched code */
+  code_write(code, iline, 0x10);
+  for (i = 0; i < BLOCK_LINES; i++)
+    mtspr(SPR_ICBPR, (unsigned long) code + i * iline);
+  code_check(code, iline, 0x10);
+
+  /* Locked code, replaced after the invalidate */
+  for (i = 0; i < BLOCK_LINES; i++)
+    mtspr(SPR_ICBLR, (unsigned long) code + i * iline);
+  code_check(code, iline, 0x10);
+  code_write(code, iline, 0x20);
+  code_check(code, iline, 0x20);
+  report(((unsigned long (*) (void)) code) ());
+
+  report(0x8000000d);
+  exit(0);
+}
@@ -0,0 +1,116 @@
+/*
+ * Cycle timing test
+ *
+ * Checks the timer.h routines against busy loops of known length:
+ *  - an empty region times to nearly nothing once calibrated
+ *  - a loop of LOOP_ITERS iterations takes at least that many cycles
+ *  - cycles_now64() never goes backwards
+ *  - timer_bench() leaves its samples sorted, none shorter than the
+ *    loop timed
+ *  - with TTCR as the source, a region across a TTCR wrap still times
+ *    right and cycles_now64() counts the wrap
+ *
+ * Reports the cycle source and timer_overhead first. Without a cycle
+ * source there is nothing to check.
+ */
+
+#include "support.h"
+#include "spr-defs.h"
+#include "timer.h"
+
+#define LOOP_ITERS	1000
+#define EMPTY_MAX	32
+#define REPS		9
+
+static void
+fail(unsigned long where)
+{
+  report(where);
+  report(0xbaaaaaad);
+  exit(1);
+}
+
+static void
+loop(void *arg)
+{
+  volatile unsigned long i;
+
+  for (i = 0; i < (unsigned long) arg; i++)
+    ;
+}
+
+int
+main(void)
+{
+  unsigned long src = timer_init();
+  unsigned long samples[REPS];
+  struct timer_stats stats;
+  unsigned long long t0, t1;
+  unsigned long start, e;
+  int i;
+
+  report(src);
+  report(timer_overhead);
+
+  if (src == TIMER_NONE)
+    {
+      report(0x8000000d);
+      exit(0);
+    }
+
+  /* Twice, the first may miss in the caches */
+  e = cycles_elapsed(cycles_now());
+  e = cycles_elapsed(cycles_now());
+  report(e);
+  if (e > EMPTY_MAX)
+    fail(1);
+
+  start = cycles_now();
+  loop((void *) LOOP_ITERS);
+  e = cycles_elapsed(start);
+  report(e);
+  if (e < LOOP_ITERS)
+    fail(2);
+
+  t0 = cycles_now64();
+  for (i = 0; i < 4; i++)
+    {
+      loop((void *) 16);
+      t1 = cycles_now64();
+      if (t1 < t0)
+	fail(3);
+      t0 = t1;
+    }
+
+  if (timer_bench(loop, (void *) LOOP_ITERS, 2, REPS, samples,
+		  &stats) != REPS)
+    fail(4);
+  report(stats.min);
+  report(stats.median);
+  report(stats.max);
+  for (i = 1; i < REPS; i++)
+    if (samples[i - 1] > samples[i])
+      fail(5);
+  if (stats.min != samples[0] || stats.median != samples[REPS / 2] ||
+      stats.max != samples[REPS - 1] || stats.min < LOOP_ITERS)
+    fail(6);
+
+  if (src == TIMER_TTCR)
+    {
+      /* Close enough to the wrap for the loop to cross it */
+      mtspr(SPR_TTCR, 0xffffff00);
+      t0 = cycles_now64();
+      start = cycles_now();
+      loop((void *) LOOP_ITERS);
+      e = cycles_elapsed(start);
+      t1 = cycles_now64();
+      report(e);
+      if (e < LOOP_ITERS || e > 100 * LOOP_ITERS)
+	fail(7);
+      if ((t1 >> 32) != (t0 >> 32) + 1 || t1 < t0)
+	fail(8);
+    }
+
+  report(0x8000000d);
+  exit(0);
+}
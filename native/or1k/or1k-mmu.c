@@ -57,13 +57,13 @@
 // desired address, and either data or the return instructions are placed
 // where we expect the MMU to translate to)
 
-#include <stdio.h>
 #include <stdlib.h>
 #include <or1k-support.h>
 #include <or1k-sprs.h>
 
 #include "support.h"
 #include "board.h"
+#include "tprintf.h"
 
 /* These are defined wrong in newlib, fix them here until patch goes upstream.  */
 #undef OR1K_SPR_IMMU_ITLBW_TR_UXE_MASK
@@ -212,14 +212,14 @@ static void call (unsigned long add)
 static void bus_err_handler (void)
 {
   /* This shouldn't happend */
-  puts ("Test failed: Bus error");
+  tputs ("Test failed: Bus error");
   report (0xeeeeeeee);
   exit (1);
 }
 
 static void tick_timer_handler (void)
 {
-  puts("Tick from timer?");
+  tputs("Tick from timer?");
   or1k_timer_disable();
   exit (1);
 }
@@ -228,7 +228,7 @@ static void tick_timer_handler (void)
 static void ill_insn_handler (void)
 {
   /* This shouldn't happend */
-  puts("Test failed: Illegal insn");
+  tputs("Test failed: Illegal insn");
   report (0xeeeeeeee);
   exit (1);
 }
@@ -543,7 +543,7 @@ static int dtlb_translation_test (void)
   /* Disable DMMU */
   dmmu_disable();
 
-  puts("dtlb translation test set");
+  tputs("dtlb translation test set");
 
   /* Set dtlb miss handler default permisions and set translation */
   reset_tlb_handler_config ();
@@ -564,10 +564,10 @@ static int dtlb_translation_test (void)
     mtspr (OR1K_SPR_DMMU_DTLBW_TR_ADDR(dtlb_ways - 1, i), ta | DTLB_PR_NOLIMIT);
   }
 
-  puts("Enabling DMMU");
+  tputs("Enabling DMMU");
   dmmu_enable();
 
-  puts("check 1 - mid to mid");
+  tputs("check 1 - mid to mid");
   /* Check the pattern */
   for (i = TLB_DATA_SET_NB; i < dtlb_sets; i++) {
     ea = RAM_START + (RAM_SIZE/2) + (i*PAGE_SIZE);
@@ -594,7 +594,7 @@ static int dtlb_translation_test (void)
   }
   dmmu_enable();
 
-  puts("check 2 - low to mid");
+  tputs("check 2 - low to mid");
   /* Check the pattern */
   for (i = TLB_DATA_SET_NB; i < dtlb_sets; i++) {
     ea = i*PAGE_SIZE;
@@ -625,7 +625,7 @@ static int dtlb_translation_test (void)
   }
   dmmu_enable();
 
-  puts("check 3 - swapped");
+  tputs("check 3 - swapped");
   /* Check the pattern */
   for (i = TLB_DATA_SET_NB; i < dtlb_sets; i++) {
     int swap = dtlb_swap_set_translate(i);
@@ -643,9 +643,9 @@ static int dtlb_translation_test (void)
   }
 
   dmmu_disable();
-  puts("Disabled DMMU");
+  tputs("Disabled DMMU");
 
-  puts("check 4 - swapped mmu off");
+  tputs("check 4 - swapped mmu off");
   /* Check the pattern */
   for (i = TLB_DATA_SET_NB; i < dtlb_sets; i++) {
     int swap = dtlb_swap_set_translate(i);
@@ -658,7 +658,7 @@ static int dtlb_translation_test (void)
 
   dtlb_set_translate = &tlb_default_set_translate;
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
   return 0;
 }
 
@@ -678,7 +678,7 @@ static int dtlb_match_test (int way, int set)
   /* Disable DMMU */
   dmmu_disable();
 
-  printf("dtlb_match_test - way %d set %d\n", way, set);
+  tprintf("dtlb_match_test - way %d set %d\n", way, set);
 
   /* Set dtlb permisions and set translation used in tlb miss handler */
   reset_tlb_handler_config ();
@@ -748,7 +748,7 @@ static int dtlb_match_test (int way, int set)
     }
   }
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -768,7 +768,7 @@ static int dtlb_valid_bit_test (int set)
   /* Disable DMMU */
   dmmu_disable();
 
-  printf("dtlb_valid_bit_test, set %d\n", set);
+  tprintf("dtlb_valid_bit_test, set %d\n", set);
 
   reset_tlb_miss_counts ();
   reset_tlb_handler_config ();
@@ -778,7 +778,7 @@ static int dtlb_valid_bit_test (int set)
     mtspr (OR1K_SPR_DMMU_DTLBW_MR_ADDR(i, set), 0);
   }
 
-  puts ("check 1 - tlb miss counts unmapped");
+  tputs ("check 1 - tlb miss counts unmapped");
   /* Enable DMMU */
   dmmu_enable();
 
@@ -795,7 +795,7 @@ static int dtlb_valid_bit_test (int set)
 
   reset_tlb_miss_counts ();
 
-  puts ("check 2 - tlb miss counts mapped");
+  tputs ("check 2 - tlb miss counts mapped");
 
   /* Perform reads to address, that is now in DTLB */
   for (i = 0; i < dtlb_ways; i++) {
@@ -812,7 +812,7 @@ static int dtlb_valid_bit_test (int set)
     mtspr (OR1K_SPR_DMMU_DTLBW_MR_ADDR(i, set), mfspr (OR1K_SPR_DMMU_DTLBW_MR_ADDR(i, set)) & ~OR1K_SPR_DMMU_DTLBW_MR_V_MASK);
   }
 
-  puts ("check 3 - tlb miss counts mapped invalid");
+  tputs ("check 3 - tlb miss counts mapped invalid");
 
   /* Perform reads to address, that is now in DTLB but is invalid */
   for (i = 0; i < dtlb_ways; i++) {
@@ -828,7 +828,7 @@ static int dtlb_valid_bit_test (int set)
   /* Disable DMMU */
   dmmu_disable();
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -845,7 +845,7 @@ static int dtlb_permission_test (int set, enum protection mode)
   if (!(mfspr(OR1K_SPR_SYS_UPR_ADDR) & OR1K_SPR_SYS_UPR_DMP_MASK))
     return 0;
 
-  printf("dtlb_permission_test, set %d\n", set);
+  tprintf("dtlb_permission_test, set %d\n", set);
 
   /* Disable DMMU */
   dmmu_disable();
@@ -871,7 +871,7 @@ static int dtlb_permission_test (int set, enum protection mode)
     dtlb_val = DTLB_PR_NOLIMIT | OR1K_SPR_DMMU_DTLBW_TR_SWE_MASK;
     mtspr (OR1K_SPR_DMMU_DTLBW_TR_ADDR(dtlb_ways - 1, set), ea | (DTLB_PR_NOLIMIT & ~OR1K_SPR_DMMU_DTLBW_TR_SWE_MASK));
 
-    puts ("check 1 - page fault writes");
+    tputs ("check 1 - page fault writes");
     REG32(ea + 0) = 0x00112233;
     REG32(ea + 4) = 0x44556677;
     REG32(ea + 8) = 0x8899aabb;
@@ -882,7 +882,7 @@ static int dtlb_permission_test (int set, enum protection mode)
     dtlb_val = DTLB_PR_NOLIMIT | OR1K_SPR_DMMU_DTLBW_TR_SRE_MASK;
     mtspr (OR1K_SPR_DMMU_DTLBW_TR_ADDR(dtlb_ways - 1, set), ea | (DTLB_PR_NOLIMIT & ~OR1K_SPR_DMMU_DTLBW_TR_SRE_MASK));
 
-    puts ("check 2 - page fault reads");
+    tputs ("check 2 - page fault reads");
     tmp = REG32(ea + 0);
     ASSERT(tmp == 0x00112233);
     tmp = REG32(ea + 4);
@@ -899,7 +899,7 @@ static int dtlb_permission_test (int set, enum protection mode)
     dtlb_val = DTLB_PR_NOLIMIT | OR1K_SPR_DMMU_DTLBW_TR_UWE_MASK;
     mtspr (OR1K_SPR_DMMU_DTLBW_TR_ADDR(dtlb_ways - 1, set), ea | (DTLB_PR_NOLIMIT & ~OR1K_SPR_DMMU_DTLBW_TR_UWE_MASK));
 
-    puts ("check 1 - page fault writes user-mode");
+    tputs ("check 1 - page fault writes user-mode");
     REG32(ea + 0) = 0xffeeddcc;
     REG32(ea + 4) = 0xbbaa9988;
     REG32(ea + 8) = 0x77665544;
@@ -910,7 +910,7 @@ static int dtlb_permission_test (int set, enum protection mode)
     dtlb_val = DTLB_PR_NOLIMIT | OR1K_SPR_DMMU_DTLBW_TR_URE_MASK;
     mtspr (OR1K_SPR_DMMU_DTLBW_TR_ADDR(dtlb_ways - 1, set), ea | (DTLB_PR_NOLIMIT & ~OR1K_SPR_DMMU_DTLBW_TR_URE_MASK));
 
-    puts ("check 2 - page fault reads user-mode");
+    tputs ("check 2 - page fault reads user-mode");
 
     tmp = REG32(ea + 0);
     ASSERT(tmp == 0xffeeddcc);
@@ -926,7 +926,7 @@ static int dtlb_permission_test (int set, enum protection mode)
   /* Disable DMMU */
   dmmu_disable();
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -954,7 +954,7 @@ static int dtlb_dcache_test (int set)
   if (!(mfspr(OR1K_SPR_SYS_SR_ADDR) & OR1K_SPR_SYS_SR_DCE_MASK))
     return 0;
 
-  printf("dtlb_dcache_test, set %d\n", set);
+  tprintf("dtlb_dcache_test, set %d\n", set);
 
   /* Disable DMMU */
   dmmu_disable();
@@ -1025,7 +1025,7 @@ static int dtlb_dcache_test (int set)
   /* Disable DMMU */
   dmmu_disable();
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 
@@ -1042,7 +1042,7 @@ int itlb_translation_test (void)
   if (!(mfspr(OR1K_SPR_SYS_UPR_ADDR) & OR1K_SPR_SYS_UPR_IMP_MASK))
     return 0;
 
-  puts("itlb_translation_test");
+  tputs("itlb_translation_test");
 
   /* Disable IMMU */
   immu_disable ();
@@ -1108,7 +1108,7 @@ int itlb_translation_test (void)
     call(ta);
   }
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -1126,7 +1126,7 @@ static int itlb_match_test (int way, int set)
   if (!(mfspr(OR1K_SPR_SYS_UPR_ADDR) & OR1K_SPR_SYS_UPR_IMP_MASK))
     return 0;
 
-  printf("itlb_match_test - way %d set %d\n", way, set);
+  tprintf("itlb_match_test - way %d set %d\n", way, set);
 
   /* Disable IMMU */
   immu_disable();
@@ -1196,7 +1196,7 @@ static int itlb_match_test (int way, int set)
     }
   }
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   /* Disable IMMU */
   immu_disable();
@@ -1217,7 +1217,7 @@ static int itlb_valid_bit_test (int set)
   if (!(mfspr(OR1K_SPR_SYS_UPR_ADDR) & OR1K_SPR_SYS_UPR_IMP_MASK))
     return 0;
 
-  printf("itlb_valid_bit_test set = %d\n", set);
+  tprintf("itlb_valid_bit_test set = %d\n", set);
 
   /* Disable IMMU */
   immu_disable();
@@ -1272,7 +1272,7 @@ static int itlb_valid_bit_test (int set)
   /* Disable IMMU */
   immu_disable();
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -1289,7 +1289,7 @@ static int itlb_permission_test (int set, enum protection mode)
   if (!(mfspr(OR1K_SPR_SYS_UPR_ADDR) & OR1K_SPR_SYS_UPR_IMP_MASK))
     return 0;
 
-  printf("itlb_permission_test set = %d\n", set);
+  tprintf("itlb_permission_test set = %d\n", set);
 
   /* Disable IMMU */
   immu_disable();
@@ -1319,7 +1319,7 @@ static int itlb_permission_test (int set, enum protection mode)
 
   if (mode == supervisor_mode) {
     /* Execute supervisor */
-    puts ("check 1 - page fault exec supervisor");
+    tputs ("check 1 - page fault exec supervisor");
     itlb_val = OR1K_SPR_IMMU_ITLBW_TR_CI_MASK | OR1K_SPR_IMMU_ITLBW_TR_SXE_MASK;
     mtspr (OR1K_SPR_IMMU_ITLBW_TR_ADDR(itlb_ways - 1, set), ea | (ITLB_PR_NOLIMIT & ~OR1K_SPR_IMMU_ITLBW_TR_SXE_MASK));
 
@@ -1329,7 +1329,7 @@ static int itlb_permission_test (int set, enum protection mode)
     ASSERT(ipage_fault_count == 1);
 
   } else {
-    puts ("check 1 - page fault exec user");
+    tputs ("check 1 - page fault exec user");
     /* Execute user */
     itlb_val = OR1K_SPR_IMMU_ITLBW_TR_CI_MASK | OR1K_SPR_IMMU_ITLBW_TR_UXE_MASK;
     mtspr (OR1K_SPR_IMMU_ITLBW_TR_ADDR(itlb_ways - 1, set), ea | (ITLB_PR_NOLIMIT & ~OR1K_SPR_IMMU_ITLBW_TR_UXE_MASK));
@@ -1343,7 +1343,7 @@ static int itlb_permission_test (int set, enum protection mode)
   /* Disable IMMU */
   immu_disable ();
 
-  puts("-------------------------------------------");
+  tputs("-------------------------------------------");
 
   return 0;
 }
@@ -1373,7 +1373,7 @@ int main (void)
   itlb_ways = (1 + OR1K_SPR_SYS_IMMUCFGR_NTW_GET(
 			mfspr(OR1K_SPR_SYS_IMMUCFGR_ADDR)));
 
-  printf ("PROGRAM/MEMORY DISCOVERY\n"
+  tprintf ("PROGRAM/MEMORY DISCOVERY\n"
           "  start_text_addr: %lx\n"
           "  end_text_addr: %lx\n"
           "  end_data_addr: %lx\n"
@@ -1387,7 +1387,7 @@ int main (void)
 		RAM_START,
 		RAM_SIZE, RAM_SIZE);
 
-  printf ("OR1K MMU DISCOVERY\n"
+  tprintf ("OR1K MMU DISCOVERY\n"
           "  dtlb_sets: %ld\n"
           "  dtlb_ways: %ld\n"
           "  itlb_sets: %ld\n"
@@ -1409,10 +1409,10 @@ int main (void)
   or1k_exception_handler_add (0x7, ill_insn_handler);
 
 #ifdef SHORT_TEST
-  puts("Running short tlb set tests");
+  tputs("Running short tlb set tests");
   test_dtlb_sets = test_itlb_sets = TLB_DATA_SET_NB + SHORT_TEST_NUM;
 #else
-  puts("Running full tlb set tests");
+  tputs("Running full tlb set tests");
   test_dtlb_sets = dtlb_sets;
   test_itlb_sets = itlb_sets;
 #endif
@@ -9,13 +9,18 @@
 */
 
 #include <stdlib.h>
-#include <stdio.h>
 #include "support.h"
+#include "results.h"
+#include "tprintf.h"
 
 static int smul_errors, umul_errors;
 
 #define VERBOSE_TESTS 0
 
+// Report every result as it is produced rather than all at the end,
+// the same log either way (see results.h)
+#define STREAM_RESULTS 0
+
 // Make this bigger when running on FPGA target. For simulation it's enough.
 #define NUM_TESTS 32
 
@@ -41,24 +46,24 @@ void
 check_mul(int multiplicand, int multiplier, int expected_result)
 {
 #if VERBOSE_TESTS
-  printf("l.mul  0x%.8x * 0x%.8x (%11d * %11d)= (SW) 0x%.8x (%11d) : ", multiplicand, multiplier,
+  tprintf("l.mul  0x%.8x * 0x%.8x (%11d * %11d)= (SW) 0x%.8x (%11d) : ", multiplicand, multiplier,
 	 multiplicand, multiplier, expected_result, expected_result);
 #endif
   int result =  or1k_mul(multiplicand, multiplier);
 #if VERBOSE_TESTS==0
-  report(result);
+  results_put(result);
 #endif
   if ( result != expected_result)
     {
-      printf("l.mul  0x%.8x * 0x%.8x = (SW) 0x%.8x : ", multiplicand, multiplier,
+      tprintf("l.mul  0x%.8x * 0x%.8x = (SW) 0x%.8x : ", multiplicand, multiplier,
 	     expected_result);
 
-      printf("(HW) 0x%.8x - MISMATCH\n",result);
+      tprintf("(HW) 0x%.8x - MISMATCH\n",result);
       smul_errors++;
     }
 #if VERBOSE_TESTS
   else
-    printf("OK\n");
+    tprintf("OK\n");
 #endif
 
 }
@@ -68,25 +73,25 @@ check_mulu(unsigned int multiplicand, unsigned int multiplier,
 	   unsigned int expected_result)
 {
 #if VERBOSE_TESTS
-  printf("l.mulu 0x%.8x * 0x%.8x (%11d * %11d)= (SW) 0x%.8x (%11d) : ", multiplicand, multiplier,
+  tprintf("l.mulu 0x%.8x * 0x%.8x (%11d * %11d)= (SW) 0x%.8x (%11d) : ", multiplicand, multiplier,
 	 multiplicand, multiplier, expected_result, expected_result);
 #endif
 
   unsigned int result =  or1k_mulu(multiplicand, multiplier);
 #if VERBOSE_TESTS==0
-  report(result);
+  results_put(result);
 #endif
   if ( result != expected_result)
     {
-      printf("l.mulu 0x%.8x * 0x%.8x = (SW) 0x%.8x : ", multiplicand, multiplier,
+      tprintf("l.mulu 0x%.8x * 0x%.8x = (SW) 0x%.8x : ", multiplicand, multiplier,
 	     expected_result);
 
-      printf("(HW) 0x%.8x (%d) - MISMATCH\n",result, result);
+      tprintf("(HW) 0x%.8x (%d) - MISMATCH\n",result, result);
       umul_errors++;
     }
 #if VERBOSE_TESTS
   else
-    printf("OK\n");
+    tprintf("OK\n");
 #endif
 }
 
@@ -118,6 +123,10 @@ main(void)
   uart_init(DEFAULT_UART);
 #endif
 
+#if STREAM_RESULTS
+  results_init(NULL, 0, RESULTS_STREAM);
+#endif
+
   umul_errors = 0;
   smul_errors = 0;
 
@@ -140,9 +149,9 @@ main(void)
 	d = (d>>(rand()&0x15));
 
 #if VERBOSE_TESTS
-      printf("Test %d\n", i);
+      tprintf("Test %d\n", i);
 #else
-      report(0x10101010);
+      results_put(0x10101010);
 #endif
 
       if (n&0x10) // Randomly select if we should negate n
@@ -174,9 +183,9 @@ main(void)
 
 #if VERBOSE_TESTS==0
       /* Report things */
-      report(n);
-      report(d);
-      report(expected_result);
+      results_put(n);
+      results_put(d);
+      results_put(expected_result);
 #endif
 
       /* Signed multiply */
@@ -201,25 +210,27 @@ main(void)
 
 #if VERBOSE_TESTS==0
       /* Report things */
-      report(n);
-      report(d);
-      report(expected_result);
+      results_put(n);
+      results_put(d);
+      results_put(expected_result);
 #endif
 
       /* Unsigned multiply */
       check_mulu(n, d, expected_result);
 #if VERBOSE_TESTS==0
-      report(i);
+      results_put(i);
 #endif
       i++;
 
     }
 
 
-  printf("Integer multiply check complete\n");
-  printf("Unsigned:\t%d tests\t %d errors\n",
+  results_flush();
+
+  tprintf("Integer multiply check complete\n");
+  tprintf("Unsigned:\t%d tests\t %d errors\n",
 	 NUM_TESTS, umul_errors);
-  printf("Signed:\t\t%d tests\t %d errors\n",
+  tprintf("Signed:\t\t%d tests\t %d errors\n",
 	 NUM_TESTS, smul_errors);
 
   if ((umul_errors > 0) || (smul_errors > 0))
@@ -0,0 +1,138 @@
+/*
+ * Page table test
+ *
+ * Checks the libsupport page tables and their DTLB miss handler (see
+ * pgtable.h) with RAM mapped one to one and one page of it mapped
+ * again at PGT_VA, outside of RAM and devices:
+ *  - pgtable_lookup() gives the PTE of a mapped page and 0 otherwise
+ *  - loads and stores through PGT_VA reach the physical page, through
+ *    DTLB refills from the tables
+ *  - the refill way never goes past the last way of the DTLB
+ *  - after unmap_range() the page has no PTE and, its DTLB entry
+ *    dropped, the next load through PGT_VA takes a data page fault at
+ *    PGT_VA, which maps the page again so the load completes
+ *
+ * Without a DMMU there is nothing to check.
+ */
+
+#include <or1k-support.h>
+#include "support.h"
+#include "spr-defs.h"
+#include "pgtable.h"
+#include "tlbrefill.h"
+#include "vector.h"
+
+#define PGT_VA		0x40000000
+#define PGT_WORDS	16
+
+#define DTLB_VECTOR	0x900
+
+extern char end;
+extern unsigned long _or1k_board_mem_base;
+extern unsigned long _or1k_board_mem_size;
+
+static char *pgt_page;
+static volatile unsigned long pgt_fault_count;
+static volatile unsigned long pgt_fault_ea;
+
+static void
+fail(unsigned long where)
+{
+  or1k_dmmu_disable();
+  report(where);
+  report(0xbaaaaaad);
+  exit(1);
+}
+
+/* Runs with the DMMU off, the tables are mapped one to one */
+static void
+dpage_fault_handler(void)
+{
+  pgt_fault_count++;
+  pgt_fault_ea = mfspr(SPR_EEAR_BASE);
+
+  if (map_range(PGT_VA, (unsigned long) pgt_page, PGTABLE_PAGE_SIZE,
+		PGTABLE_RW))
+    fail(0xf);
+}
+
+int
+main(void)
+{
+  /* The page mapped at PGT_VA, then the page table pool */
+  char *page = (char *) (((unsigned long) &end + 0xffff) & ~0xffff);
+  char *pool = page + PGTABLE_PAGE_SIZE;
+  unsigned long pool_size = PGTABLE_PGD_SIZE + PGTABLE_PTE_SIZE *
+    ((_or1k_board_mem_size >> PGTABLE_PGD_SHIFT) + 4);
+  volatile unsigned long *phys = (volatile unsigned long *) page;
+  volatile unsigned long *virt = (volatile unsigned long *) PGT_VA;
+  unsigned long saved[VECTOR_PATCH_WORDS];
+  unsigned long v;
+  int i;
+
+  report(!!(mfspr(SPR_UPR) & SPR_UPR_DMP));
+
+  if (!(mfspr(SPR_UPR) & SPR_UPR_DMP))
+    {
+      report(0x8000000d);
+      exit(0);
+    }
+
+  pgt_page = page;
+  if (pgtable_init(pool, pool_size) ||
+      map_range(_or1k_board_mem_base, _or1k_board_mem_base,
+		_or1k_board_mem_size, PGTABLE_RW) ||
+      map_range(PGT_VA, (unsigned long) page, PGTABLE_PAGE_SIZE,
+		PGTABLE_RW))
+    fail(1);
+
+  v = pgtable_lookup(PGT_VA + 4);
+  report(v);
+  if (v != ((unsigned long) page | PGTABLE_RW | PGTABLE_PRESENT))
+    fail(2);
+  if (pgtable_lookup(PGT_VA + PGTABLE_PAGE_SIZE))
+    fail(3);
+
+  for (i = 0; i < PGT_WORDS; i++)
+    phys[i] = 0x5a5a0000 + i;
+
+  vector_patch(DTLB_VECTOR, pgtable_dtlb_miss, saved);
+  or1k_exception_handler_add(0x3, dpage_fault_handler);
+  or1k_dmmu_enable();
+
+  for (i = 0; i < PGT_WORDS; i++)
+    if (virt[i] != 0x5a5a0000 + i)
+      fail(4);
+  virt[0] = 0xc001d00d;
+
+  or1k_dmmu_disable();
+
+  if (phys[0] != 0xc001d00d)
+    fail(5);
+  report(TLB_REFILL_VAR(TLB_REFILL_DCOUNT));
+  if (!TLB_REFILL_VAR(TLB_REFILL_DCOUNT))
+    fail(6);
+  if (TLB_REFILL_VAR(TLB_REFILL_DNEXT) > TLB_REFILL_VAR(TLB_REFILL_DWAYS))
+    fail(7);
+
+  /* The DTLB still holds PGT_VA, unmap_range() must drop it */
+  unmap_range(PGT_VA, PGTABLE_PAGE_SIZE);
+  if (pgtable_lookup(PGT_VA))
+    fail(8);
+
+  or1k_dmmu_enable();
+  v = virt[1];
+  or1k_dmmu_disable();
+
+  report(pgt_fault_count);
+  report(pgt_fault_ea);
+  if (pgt_fault_count != 1 || pgt_fault_ea != PGT_VA)
+    fail(9);
+  if (v != 0x5a5a0001)
+    fail(10);
+
+  vector_restore(DTLB_VECTOR, saved);
+
+  report(0x8000000d);
+  exit(0);
+}
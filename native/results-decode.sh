@@ -0,0 +1,29 @@
+#!/bin/sh
+#
+# SYNOPSIS
+#  ./results-decode.sh <dump> <size> <oldest> <count>
+#
+# SUMMARY
+#
+# Decodes a result ring flushed in RESULTS_DUMP mode (see
+# include/results.h). The flush reports the ring address and size, the
+# index of the oldest word and the number of words; the runner dumps
+# size words from that address to <dump> as raw big endian memory.
+# Prints the words oldest first as the report(0x...) lines a
+# RESULTS_BURST flush would have logged, so the usual log tools read
+# either. <size>, <oldest> and <count> may be given in hex (0x...) or
+# decimal.
+
+if [ $# -ne 4 ] ; then
+  echo "usage: $0 <dump> <size> <oldest> <count>" >&2
+  exit 1
+fi
+
+od -An -v -tx1 $1 | tr -s ' \n' '  ' | tr ' ' '\n' | sed '/^$/d' | \
+  awk -v size=$(($2)) -v oldest=$(($3)) -v count=$(($4)) '
+    { w = w $0 }
+    NR % 4 == 0 { word[NR / 4 - 1] = w; w = "" }
+    END {
+      for (i = 0; i < count; i++)
+        printf "report(0x%s);\n", word[(oldest + i) % size]
+    }'
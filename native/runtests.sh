@@ -17,7 +17,8 @@
 # No arguments are required, by default the script will run fusesoc sim
 # with the CAPPUCCINO pipeline.
 #
-# Arg 1     [test_pattern] A glob of the tests to run.  The default is or1k-*.
+# Arg 1     [test_pattern] A glob of the tests to run.  The default is or1k-*,
+#           or bench-* when TEST_DIR is bench.
 #
 # ENVIRONMENT VARIABLES
 #
@@ -25,6 +26,8 @@
 #             i.e. mor1kx_tb, marocchino_tb
 # TARGET_ARGS arguments to send to fusesoc target directly, i.e. --tool=verilator
 # CORE_ARGS   arguments to send to mor1kx-generic, i.e. --pipeline CAPPUCCINO
+# TEST_DIR    build subdirectory to take the tests from, i.e. or1k, bench.
+#             The default is or1k.
 # EXPECTED_FAILURES whitespace separated list of test cases that are expected
 # to fail.
 #
@@ -37,9 +40,14 @@ DIR=`dirname $0`
 CORE=mor1kx-generic
 TEST_PATTERN=$1 ; shift
 TEST_TIMEOUT=${TEST_TIMEOUT:-3m}
+TEST_DIR=${TEST_DIR:-or1k}
 
 if [ -z $TEST_PATTERN ] ; then
-  TEST_PATTERN="or1k-*"
+  if [ "$TEST_DIR" = "bench" ] ; then
+    TEST_PATTERN="bench-*"
+  else
+    TEST_PATTERN="or1k-*"
+  fi
 fi
 
 test_count=0
@@ -69,7 +77,7 @@ function end_tap_report {
   echo "1..$1" >> $TAP_REPORT_FILE
 }
 
-if [ ! -d $DIR/build/or1k ] ; then
+if [ ! -d $DIR/build/$TEST_DIR ] ; then
   echo "Cannot find any tests, did you build them?"
   exit 1
 fi
@@ -106,7 +114,7 @@ trap inthandler SIGINT
 
 initialize_tap_report
 
-for test_path in $DIR/build/or1k/${TEST_PATTERN}; do
+for test_path in $DIR/build/$TEST_DIR/${TEST_PATTERN}; do
   test_name=`basename $test_path`
   test_path=`readlink -f $test_path`
   # pattern to check EXPECTED_FAILURES with word boundary regex